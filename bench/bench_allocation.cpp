@@ -0,0 +1,154 @@
+#include "../include/arena.h"
+#include "../include/factory.h"
+#include "../include/game_engine.h"
+#include "../include/rng.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Число выделений памяти и время на создание и удаление NPC:
+// обычная куча против std::pmr пула и монотонной арены.
+// Выделения считаются заменой глобальных operator new / delete, поэтому
+// в счёт входят и блоки, которые ресурсы берут у кучи.
+namespace {
+
+std::atomic<std::uint64_t> allocations{0};
+
+}
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    std::size_t align = static_cast<std::size_t>(alignment);
+    if (void* p = std::aligned_alloc(align, (size + align - 1) / align * align)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+
+struct Result {
+    std::uint64_t allocations;
+    double create_ms;
+    double destroy_ms;
+};
+
+using Clock = std::chrono::steady_clock;
+
+double millis(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+// Имена заранее: их строки не входят в замер
+std::vector<std::string> makeNames(size_t count) {
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::string name = std::to_string(i);
+        name.insert(name.begin(), 'N');
+        names.push_back(std::move(name));
+    }
+    return names;
+}
+
+Result fillArena(const std::vector<std::string>& names, std::pmr::memory_resource* memory) {
+    const NpcTypeId kTypes[] = {NpcTypeId::Knight, NpcTypeId::Druid, NpcTypeId::Elf};
+    Result result{};
+    auto arena = std::make_unique<Arena>(MAX_WIDTH, MAX_HEIGHT, memory);
+
+    std::uint64_t before = allocations.load();
+    auto start = Clock::now();
+    for (size_t i = 0; i < names.size(); ++i) {
+        rng::CounterRng random(1, rng::Stream::Spawn, 0, i);
+        arena->addNpc(NpcFactory::createNpc(kTypes[random.uniform(0, 2)], names[i],
+                                            random.uniform(0, MAX_WIDTH), random.uniform(0, MAX_HEIGHT),
+                                            memory));
+    }
+    auto created = Clock::now();
+    arena.reset();
+    auto destroyed = Clock::now();
+
+    result.allocations = allocations.load() - before;
+    result.create_ms = millis(start, created);
+    result.destroy_ms = millis(created, destroyed);
+    return result;
+}
+
+Result fillEngine(size_t count, std::pmr::memory_resource* memory) {
+    Result result{};
+    auto engine = std::make_unique<GameEngine>(1000, 1000, memory);
+    engine->setSeed(1);
+
+    std::uint64_t before = allocations.load();
+    auto start = Clock::now();
+    engine->createRandomNpcs(static_cast<int>(count));
+    auto created = Clock::now();
+    engine.reset();
+    auto destroyed = Clock::now();
+
+    result.allocations = allocations.load() - before;
+    result.create_ms = millis(start, created);
+    result.destroy_ms = millis(created, destroyed);
+    return result;
+}
+
+void print(const char* target, size_t count, const char* memory, const Result& result) {
+    std::cout << std::fixed << std::setprecision(1)
+              << std::setw(8) << target
+              << std::setw(10) << count
+              << std::setw(12) << memory
+              << std::setw(14) << result.allocations
+              << std::setw(14) << result.create_ms
+              << std::setw(14) << result.destroy_ms << std::endl;
+}
+
+template <typename Fill>
+void compare(const char* target, size_t count, Fill fill) {
+    print(target, count, "heap", fill(nullptr));
+    {
+        std::pmr::unsynchronized_pool_resource pool;
+        print(target, count, "pool", fill(&pool));
+    }
+    {
+        std::pmr::monotonic_buffer_resource monotonic;
+        print(target, count, "monotonic", fill(&monotonic));
+    }
+}
+
+}
+
+int main() {
+    const size_t kCounts[] = {100000, 1000000};
+
+    std::cout << std::setw(8) << "target"
+              << std::setw(10) << "NPCs"
+              << std::setw(12) << "memory"
+              << std::setw(14) << "allocations"
+              << std::setw(14) << "create (ms)"
+              << std::setw(14) << "destroy (ms)" << std::endl;
+
+    for (size_t count : kCounts) {
+        std::vector<std::string> names = makeNames(count);
+        compare("arena", count, [&](std::pmr::memory_resource* memory) { return fillArena(names, memory); });
+    }
+    for (size_t count : kCounts) {
+        compare("engine", count, [&](std::pmr::memory_resource* memory) { return fillEngine(count, memory); });
+    }
+    return 0;
+}
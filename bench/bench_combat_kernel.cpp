@@ -0,0 +1,144 @@
+#include "../include/combat_kernel.h"
+#include "../include/factory.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Проверка пар "NPC против следующих kBlock NPC": скалярный цикл через
+// Npc::distanceTo против пакетного ядра (скалярного и AVX2).
+namespace {
+
+const size_t kBlock = 256;
+
+struct World {
+    std::vector<NpcPtr> npcs;
+    std::vector<int> xs;
+    std::vector<int> ys;
+    std::vector<NpcTypeId> types;
+    std::vector<std::uint8_t> alive;
+};
+
+World makeWorld(size_t count) {
+    std::mt19937 gen(1);
+    int side = static_cast<int>(std::sqrt(count / 0.005));
+    std::uniform_int_distribution<> coord(0, side - 1);
+    const char* names[] = {"Knight", "Druid", "Elf"};
+
+    World world;
+    for (size_t i = 0; i < count; ++i) {
+        auto npc = NpcFactory::createNpc(names[i % 3], "Npc" + std::to_string(i), coord(gen), coord(gen));
+        world.xs.push_back(npc->getX());
+        world.ys.push_back(npc->getY());
+        world.types.push_back(npc->getTypeId());
+        world.alive.push_back(1);
+        world.npcs.push_back(std::move(npc));
+    }
+    // Сортировка по x: в блоке оказываются соседи, как в ячейках сетки
+    std::vector<size_t> order(count);
+    for (size_t i = 0; i < count; ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return world.xs[a] < world.xs[b]; });
+
+    World sorted;
+    for (size_t i : order) {
+        sorted.xs.push_back(world.xs[i]);
+        sorted.ys.push_back(world.ys[i]);
+        sorted.types.push_back(world.types[i]);
+        sorted.alive.push_back(1);
+        sorted.npcs.push_back(std::move(world.npcs[i]));
+    }
+    return sorted;
+}
+
+size_t runDistanceTo(const World& world) {
+    const CombatRules& rules = kDefaultCombatRules;
+    size_t found = 0;
+    for (size_t i = 0; i < world.npcs.size(); ++i) {
+        const Npc& a = *world.npcs[i];
+        size_t end = std::min(world.npcs.size(), i + 1 + kBlock);
+        for (size_t j = i + 1; j < end; ++j) {
+            const Npc& b = *world.npcs[j];
+            int radius = std::max(rules.getStats(a.getTypeId()).kill_distance,
+                                  rules.getStats(b.getTypeId()).kill_distance);
+            if (a.distanceTo(b) > radius) continue;
+            if (rules.canKill(a.getTypeId(), b.getTypeId()) ||
+                rules.canKill(b.getTypeId(), a.getTypeId())) {
+                ++found;
+            }
+        }
+    }
+    return found;
+}
+
+size_t runKernel(const World& world, combat_kernel::Impl impl) {
+    combat_kernel::setImpl(impl);
+    auto tables = combat_kernel::makeTables(kDefaultCombatRules);
+    std::vector<std::uint32_t> hits(kBlock);
+
+    size_t found = 0;
+    for (size_t i = 0; i < world.xs.size(); ++i) {
+        size_t begin = i + 1;
+        size_t count = std::min(world.xs.size(), begin + kBlock) - begin;
+        combat_kernel::Probe probe{world.xs[i], world.ys[i], world.types[i]};
+        combat_kernel::Block block{world.xs.data() + begin, world.ys.data() + begin,
+                                   world.types.data() + begin, world.alive.data() + begin, count};
+        found += combat_kernel::findHits(probe, block, tables, hits.data());
+    }
+    return found;
+}
+
+template <typename Fn>
+double measureNsPerPair(size_t pairs, size_t& result, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    result = fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / pairs;
+}
+
+}
+
+int main() {
+    std::cout << "AVX2: " << (combat_kernel::isAvx2Supported() ? "yes" : "no") << std::endl;
+    std::cout << std::setw(10) << "NPCs"
+              << std::setw(20) << "distanceTo ns/pair"
+              << std::setw(16) << "scalar ns/pair"
+              << std::setw(14) << "avx2 ns/pair"
+              << std::setw(10) << "hits" << std::endl;
+
+    for (size_t count : {1000, 10000, 100000}) {
+        World world = makeWorld(count);
+        size_t pairs = count * kBlock;
+
+        size_t reference = 0;
+        size_t scalar = 0;
+        size_t avx2 = 0;
+        double referenceNs = measureNsPerPair(pairs, reference, [&] { return runDistanceTo(world); });
+        double scalarNs = measureNsPerPair(pairs, scalar, [&] {
+            return runKernel(world, combat_kernel::Impl::Scalar);
+        });
+
+        std::cout << std::setw(10) << count << std::fixed << std::setprecision(3)
+                  << std::setw(20) << referenceNs
+                  << std::setw(16) << scalarNs;
+        if (combat_kernel::isAvx2Supported()) {
+            double avx2Ns = measureNsPerPair(pairs, avx2, [&] {
+                return runKernel(world, combat_kernel::Impl::Avx2);
+            });
+            std::cout << std::setw(14) << avx2Ns;
+        } else {
+            std::cout << std::setw(14) << "-";
+        }
+        std::cout << std::setw(10) << scalar << std::endl;
+
+        if (reference != scalar || (avx2 != 0 && avx2 != scalar)) {
+            std::cerr << "Mismatch: " << reference << " / " << scalar << " / " << avx2 << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
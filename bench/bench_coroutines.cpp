@@ -0,0 +1,100 @@
+#include "../include/game_engine.h"
+#include "../include/thread_pool.h"
+#include "../include/tick_scheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+// Однопоточный режим корутин против пула потоков.
+// 1) Шагов в секунду на полной симуляции (плотность как в основной программе).
+// 2) Цена переключения: возобновление пустой корутины против пустой задачи пула.
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ticksPerSecond(GameEngine::ExecutionMode mode, int count, int steps) {
+    const double kDensity = 50.0 / (100.0 * 100.0);
+    int side = static_cast<int>(std::sqrt(count / kDensity));
+
+    GameEngine engine(side, side);
+    engine.setExecutionMode(mode);
+    engine.createRandomNpcs(count);
+
+    std::ostringstream sink;
+    std::streambuf* original = std::cout.rdbuf(sink.rdbuf());
+
+    engine.step();  // прогрев: пул / создание корутин
+    auto start = Clock::now();
+    for (int i = 0; i < steps; ++i) {
+        engine.step();
+    }
+    auto end = Clock::now();
+
+    engine.flushEvents();
+    std::cout.rdbuf(original);
+    return steps / std::chrono::duration<double>(end - start).count();
+}
+
+TickTask idle(TickScheduler& scheduler) {
+    for (;;) {
+        co_await scheduler.nextTick();
+    }
+}
+
+double resumeNs(size_t routines, int ticks) {
+    TickScheduler scheduler;
+    for (size_t i = 0; i < routines; ++i) {
+        scheduler.spawn(idle(scheduler));
+    }
+    scheduler.runTick();
+
+    auto start = Clock::now();
+    for (int i = 0; i < ticks; ++i) {
+        scheduler.runTick();
+    }
+    auto end = Clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / (routines * ticks);
+}
+
+double poolTaskNs(size_t tasks, int rounds) {
+    ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+
+    auto start = Clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        std::vector<ThreadPool::Task> batch(tasks, [] {});
+        pool.run(std::move(batch));
+    }
+    auto end = Clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / (tasks * rounds);
+}
+
+}
+
+int main() {
+    const int kCounts[] = {10000, 50000, 100000};
+    const int kSteps = 5;
+
+    std::cout << std::setw(10) << "NPCs"
+              << std::setw(18) << "threaded (t/s)"
+              << std::setw(18) << "coroutines (t/s)" << std::endl;
+
+    for (int count : kCounts) {
+        double threaded = ticksPerSecond(GameEngine::ExecutionMode::Threaded, count, kSteps);
+        double coroutines = ticksPerSecond(GameEngine::ExecutionMode::Coroutines, count, kSteps);
+
+        std::cout << std::setw(10) << count
+                  << std::setw(18) << std::fixed << std::setprecision(2) << threaded
+                  << std::setw(18) << std::fixed << std::setprecision(2) << coroutines << std::endl;
+    }
+
+    std::cout << std::endl
+              << "switch cost: coroutine resume " << std::setprecision(1) << resumeNs(10000, 100)
+              << " ns, pool task " << poolTaskNs(10000, 100) << " ns" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include "../include/game_engine.h"
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+// Сравнение времени поиска боевых пар: полный перебор против сетки.
+// Плотность NPC как в основной программе: 50 NPC на карте 100x100.
+namespace {
+
+double measureMs(GameEngine& engine, GameEngine::DetectionMode mode, size_t& pairs) {
+    engine.setDetectionMode(mode);
+    auto start = std::chrono::steady_clock::now();
+    pairs = engine.findCombatPairs().size();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+}
+
+int main() {
+    const int kCounts[] = {1000, 5000, 10000, 50000, 100000, 500000};
+    const int kBruteForceLimit = 5000;
+    const double kDensity = 50.0 / (100.0 * 100.0);
+
+    std::cout << std::setw(10) << "NPCs"
+              << std::setw(16) << "brute (ms)"
+              << std::setw(16) << "grid (ms)"
+              << std::setw(12) << "pairs" << std::endl;
+
+    for (int count : kCounts) {
+        int side = static_cast<int>(std::sqrt(count / kDensity));
+        GameEngine engine(side, side);
+        engine.createRandomNpcs(count);
+
+        size_t gridPairs = 0;
+        double gridMs = measureMs(engine, GameEngine::DetectionMode::Grid, gridPairs);
+
+        std::cout << std::setw(10) << count;
+        if (count <= kBruteForceLimit) {
+            size_t brutePairs = 0;
+            double bruteMs = measureMs(engine, GameEngine::DetectionMode::BruteForce, brutePairs);
+            std::cout << std::setw(16) << std::fixed << std::setprecision(2) << bruteMs;
+        } else {
+            std::cout << std::setw(16) << "-";
+        }
+        std::cout << std::setw(16) << std::fixed << std::setprecision(2) << gridMs
+                  << std::setw(12) << gridPairs << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include "../include/async_file_observer.h"
+#include "../include/event_sink.h"
+#include "../include/file_observer.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Запись событий боя в файл: FileObserver (открытие и закрытие файла на
+// каждое событие) против AsyncFileObserver (очередь и запись блоками).
+// Отдельно - время notify на стороне вызывающего, без учёта дозаписи,
+// и полное время вместе с деструктором, который дописывает очередь.
+// Во второй таблице - журнал боёв в /dev/null: строка с std::endl на каждое
+// событие против записи EventRecord в EventSink.
+namespace {
+
+template <typename Fn>
+double seconds(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::vector<std::string> makeEvents(size_t count) {
+    std::vector<std::string> events;
+    events.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        events.push_back("Knight_" + std::to_string(i) + " (Knight) killed Elf_" +
+                         std::to_string(i + 1) + " (Elf)");
+    }
+    return events;
+}
+
+}
+
+int main() {
+    const size_t kCounts[] = {10000, 100000};
+    const auto filename = (std::filesystem::temp_directory_path() / "bench_observer.txt").string();
+
+    std::cout << std::setw(10) << "events"
+              << std::setw(16) << "file (ms)"
+              << std::setw(16) << "notify (ms)"
+              << std::setw(16) << "async (ms)"
+              << std::setw(10) << "blocks" << std::endl;
+
+    for (size_t count : kCounts) {
+        std::vector<std::string> events = makeEvents(count);
+
+        std::remove(filename.c_str());
+        double sync = seconds([&] {
+            FileObserver observer(filename);
+            for (const std::string& event : events) observer.notify(event);
+        });
+
+        std::remove(filename.c_str());
+        double notify = 0.0;
+        std::uint64_t blocks = 0;
+        double async = seconds([&] {
+            AsyncFileObserver observer(filename);
+            notify = seconds([&] {
+                for (const std::string& event : events) observer.notify(event);
+            });
+            observer.flush();
+            blocks = observer.getBatches();
+        });
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << std::setw(10) << count
+                  << std::setw(16) << sync * 1000.0
+                  << std::setw(16) << notify * 1000.0
+                  << std::setw(16) << async * 1000.0
+                  << std::setw(10) << blocks << std::endl;
+    }
+
+    std::remove(filename.c_str());
+
+    std::cout << "\n" << std::setw(10) << "events"
+              << std::setw(16) << "endl (ns/ev)"
+              << std::setw(16) << "push (ns/ev)"
+              << std::setw(16) << "sink (ms)" << std::endl;
+
+    std::ofstream null_out("/dev/null");
+    const std::vector<std::string> names = makeEvents(1000);
+    for (size_t count : kCounts) {
+        double per_line = seconds([&] {
+            for (size_t i = 0; i < count; ++i) {
+                null_out << "[COMBAT] " << names[i % names.size()] << " killed "
+                         << names[(i + 1) % names.size()] << std::endl;
+            }
+        });
+
+        double push = 0.0;
+        double total = seconds([&] {
+            EventSink sink(null_out);
+            std::uint32_t source = sink.addSource([&names](const EventRecord& record, std::string_view,
+                                                           std::string& out) {
+                out += "[COMBAT] ";
+                out += names[record.attacker];
+                out += " killed ";
+                out += names[record.defender];
+                out += '\n';
+            });
+            push = seconds([&] {
+                for (size_t i = 0; i < count; ++i) {
+                    sink.push({i, static_cast<std::uint32_t>(i % names.size()),
+                               static_cast<std::uint32_t>((i + 1) % names.size()), source,
+                               EventKind::Kill});
+                }
+            });
+            sink.flush();
+        });
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << std::setw(10) << count
+                  << std::setw(16) << per_line * 1e9 / count
+                  << std::setw(16) << push * 1e9 / count
+                  << std::setw(16) << total * 1000.0 << std::endl;
+    }
+    return 0;
+}
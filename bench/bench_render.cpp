@@ -0,0 +1,141 @@
+#include "../include/map_renderer.h"
+#include "../include/rng.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Время вывода кадра карты в зависимости от размера карты.
+// Сравниваются прежний вывод (посимвольно в поток через вектор векторов),
+// MapRenderer с полным кадром и MapRenderer в режиме Diff, когда за кадр
+// сдвигается каждый NPC. Вывод идёт в /dev/null.
+namespace {
+
+WorldSnapshot makeSnapshot(int side, size_t count) {
+    WorldSnapshot snapshot;
+    snapshot.width = side;
+    snapshot.height = side;
+    snapshot.names = std::make_shared<const std::vector<std::string>>();
+    for (size_t i = 0; i < count; ++i) {
+        rng::CounterRng random(1, rng::Stream::Spawn, 0, i);
+        snapshot.xs.push_back(random.uniform(0, side - 1));
+        snapshot.ys.push_back(random.uniform(0, side - 1));
+        snapshot.types.push_back(static_cast<NpcTypeId>(random.uniform(0, 2)));
+        snapshot.alive.push_back(1);
+    }
+    return snapshot;
+}
+
+void moveAll(WorldSnapshot& snapshot, std::uint64_t tick) {
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        rng::CounterRng random(1, rng::Stream::Movement, tick, i);
+        snapshot.xs[i] = std::clamp(snapshot.xs[i] + random.uniform(-1, 1), 0, snapshot.width - 1);
+        snapshot.ys[i] = std::clamp(snapshot.ys[i] + random.uniform(-1, 1), 0, snapshot.height - 1);
+    }
+}
+
+// Прежняя реализация printMap
+void legacyRender(const WorldSnapshot& snapshot, std::ostream& out) {
+    int width = snapshot.width;
+    int height = snapshot.height;
+    std::vector<std::vector<char>> map(height, std::vector<char>(width, '.'));
+    int alive_count = 0;
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        if (!snapshot.isAlive(i)) continue;
+        alive_count++;
+        char& cell = map[snapshot.ys[i]][snapshot.xs[i]];
+        cell = cell == '.' ? npcTypeName(snapshot.types[i])[0] : '*';
+    }
+
+    out << "\n+====================================================================================================+\n";
+    out << "|                                    [MAP] GAME WORLD STATE                                         |\n";
+    out << "+----------------------------------------------------------------------------------------------------+\n";
+    out << "|   ";
+    for (int x = 0; x < width; x += 10) out << std::setw(9) << x;
+    out << "|\n";
+    for (int y = 0; y < height; y++) {
+        out << "| " << std::setw(2) << y << " ";
+        for (int x = 0; x < width; x++) out << map[y][x];
+        out << " |\n";
+    }
+    out << "+----------------------------------------------------------------------------------------------------+\n";
+    out << "| Legend: . = empty, * = multiple NPCs, Letter = NPC type (K=Knight, D=Druid, E=Elf, O=Orc, etc.)  |\n";
+    out << "| Alive NPCs: " << alive_count << "/" << snapshot.size();
+    for (int i = alive_count; i < 12; i++) out << " ";
+    out << "|\n";
+    out << "+====================================================================================================+\n";
+    out << std::flush;
+}
+
+template <typename Fn>
+double perFrameMicros(int frames, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) fn(frame);
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / frames;
+}
+
+}
+
+int main() {
+    const int kSides[] = {100, 250, 500, 1000};
+    const int kFrames = 20;
+
+    std::FILE* null = std::fopen("/dev/null", "w");
+    if (!null) {
+        std::cerr << "Cannot open /dev/null" << std::endl;
+        return 1;
+    }
+    std::ostringstream legacy_sink;
+
+    std::cout << "Frames: " << kFrames << ", 1 NPC per 200 cells" << std::endl;
+    std::cout << std::setw(12) << "map"
+              << std::setw(14) << "legacy (us)"
+              << std::setw(12) << "full (us)"
+              << std::setw(12) << "diff (us)"
+              << std::setw(14) << "diff bytes" << std::endl;
+
+    for (int side : kSides) {
+        size_t count = static_cast<size_t>(side) * side / 200;
+        WorldSnapshot snapshot = makeSnapshot(side, count);
+
+        double legacy = perFrameMicros(kFrames, [&](int frame) {
+            moveAll(snapshot, static_cast<std::uint64_t>(frame));
+            legacy_sink.str({});
+            legacyRender(snapshot, legacy_sink);
+            std::fwrite(legacy_sink.str().data(), 1, legacy_sink.str().size(), null);
+        });
+
+        MapRenderer full_renderer(side, side);
+        double full = perFrameMicros(kFrames, [&](int frame) {
+            moveAll(snapshot, static_cast<std::uint64_t>(frame));
+            const std::string& text = full_renderer.render(snapshot);
+            std::fwrite(text.data(), 1, text.size(), null);
+        });
+
+        MapRenderer diff_renderer(side, side);
+        diff_renderer.render(snapshot, MapRenderer::Mode::Diff);
+        size_t diff_bytes = 0;
+        double diff = perFrameMicros(kFrames, [&](int frame) {
+            moveAll(snapshot, static_cast<std::uint64_t>(frame));
+            const std::string& text = diff_renderer.render(snapshot, MapRenderer::Mode::Diff);
+            diff_bytes += text.size();
+            std::fwrite(text.data(), 1, text.size(), null);
+        });
+
+        std::cout << std::setw(7) << side << "x" << std::setw(4) << side
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(14) << legacy
+                  << std::setw(12) << full
+                  << std::setw(12) << diff
+                  << std::setw(14) << diff_bytes / kFrames << std::endl;
+    }
+
+    std::fclose(null);
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include "../include/game_engine.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+// Масштабирование шага симуляции по числу потоков пула: 1, 2, 4 ... N.
+// Плотность NPC как в основной программе: 50 NPC на карте 100x100.
+// Сообщения [COMBAT] перенаправляются в строковый буфер.
+// Максимальное число потоков можно передать аргументом (по умолчанию - число ядер).
+namespace {
+
+double measureStepMs(size_t workers, int count, int steps) {
+    const double kDensity = 50.0 / (100.0 * 100.0);
+    int side = static_cast<int>(std::sqrt(count / kDensity));
+
+    GameEngine engine(side, side);
+    engine.setWorkerCount(workers);
+    engine.createRandomNpcs(count);
+
+    std::ostringstream sink;
+    std::streambuf* original = std::cout.rdbuf(sink.rdbuf());
+
+    engine.step();  // прогрев пула
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < steps; ++i) {
+        engine.step();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    engine.flushEvents();
+    std::cout.rdbuf(original);
+    return std::chrono::duration<double, std::milli>(end - start).count() / steps;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    const int kCount = 100000;
+    const int kSteps = 5;
+    size_t max_workers = std::max(1u, std::thread::hardware_concurrency());
+    if (argc > 1) {
+        max_workers = std::max(1, std::atoi(argv[1]));
+    }
+
+    std::cout << "NPCs: " << kCount << ", steps: " << kSteps << std::endl;
+    std::cout << std::setw(10) << "threads"
+              << std::setw(16) << "step (ms)"
+              << std::setw(12) << "speedup" << std::endl;
+
+    double base = 0.0;
+    for (size_t workers = 1; ; workers = std::min(workers * 2, max_workers)) {
+        double ms = measureStepMs(workers, kCount, kSteps);
+        if (workers == 1) base = ms;
+
+        std::cout << std::setw(10) << workers
+                  << std::setw(16) << std::fixed << std::setprecision(2) << ms
+                  << std::setw(12) << std::setprecision(2) << base / ms << std::endl;
+
+        if (workers == max_workers) break;
+    }
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include "../include/arena.h"
+#include "../include/factory.h"
+#include "../include/rng.h"
+#include "../include/mapped_file.h"
+#include "../include/text_scenario.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Скорость сохранения и загрузки сценария арены в текстовом и двоичном
+// формате, загрузка последовательная и параллельная (потоков по числу ядер).
+// Время загрузки включает создание NPC и вставку в арену.
+// Отдельно - только разбор текста: istringstream на строку против
+// text_scenario::parseLine по буферу файла.
+namespace {
+
+void fill(Arena& arena, size_t count) {
+    const char* kTypes[] = {"Knight", "Druid", "Elf"};
+    for (size_t i = 0; i < count; ++i) {
+        rng::CounterRng random(1, rng::Stream::Spawn, 0, i);
+        const char* type = kTypes[random.uniform(0, 2)];
+        arena.createAndAddNpc(type, std::string(type) + "_" + std::to_string(i),
+                              random.uniform(0, MAX_WIDTH), random.uniform(0, MAX_HEIGHT));
+    }
+}
+
+// Прежний разбор: getline и istringstream на каждую строку
+long long parseWithStreams(const std::string& filename) {
+    std::ifstream file(filename);
+    std::string line;
+    long long checksum = 0;
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+        std::istringstream iss(line);
+        std::string type, name;
+        int x, y;
+        iss >> type >> name >> x >> y;
+        checksum += x + y + static_cast<long long>(name.size());
+    }
+    return checksum;
+}
+
+long long parseWithViews(const std::string& filename) {
+    MappedFile file(filename);
+    long long checksum = 0;
+    text_scenario::forEachRecord(file.view(), [&](const text_scenario::Record& record, size_t) {
+        checksum += record.x + record.y + static_cast<long long>(record.name.size());
+    });
+    return checksum;
+}
+
+template <typename Fn>
+double seconds(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+int main() {
+    const size_t kCounts[] = {100000, 1000000};
+    const auto directory = std::filesystem::temp_directory_path();
+    std::ostringstream parse_report;
+
+    std::cout << std::setw(10) << "NPCs"
+              << std::setw(8) << "format"
+              << std::setw(12) << "size (MB)"
+              << std::setw(12) << "save (ms)"
+              << std::setw(12) << "load (ms)"
+              << std::setw(16) << "parallel (ms)"
+              << std::setw(16) << "load (MB/s)" << std::endl;
+
+    for (size_t count : kCounts) {
+        Arena source;
+        fill(source, count);
+
+        for (Arena::FileFormat format : {Arena::FileFormat::Text, Arena::FileFormat::Binary}) {
+            bool binary = format == Arena::FileFormat::Binary;
+            std::string filename = (directory / (binary ? "bench_scenario.bin" : "bench_scenario.txt")).string();
+
+            double save = seconds([&] { source.saveToFile(filename, format); });
+
+            Arena target;
+            double load = seconds([&] { target.loadFromFile(filename); });
+
+            Arena parallel_target;
+            parallel_target.setLoadMode(Arena::LoadMode::Parallel);
+            double parallel = seconds([&] { parallel_target.loadFromFile(filename); });
+
+            if (target.getNpcCount() != count || parallel_target.getNpcCount() != count) {
+                std::cerr << "Loaded " << target.getNpcCount() << " of " << count << std::endl;
+                return 1;
+            }
+
+            double megabytes = static_cast<double>(std::filesystem::file_size(filename)) / (1024.0 * 1024.0);
+            std::cout << std::setw(10) << count
+                      << std::setw(8) << (binary ? "binary" : "text")
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(12) << megabytes
+                      << std::setw(12) << save * 1000.0
+                      << std::setw(12) << load * 1000.0
+                      << std::setw(16) << parallel * 1000.0
+                      << std::setw(16) << megabytes / load << std::endl;
+
+            if (!binary) {
+                long long expected = 0;
+                long long actual = 0;
+                double streams = seconds([&] { expected = parseWithStreams(filename); });
+                double views = seconds([&] { actual = parseWithViews(filename); });
+                if (expected != actual) {
+                    std::cerr << "Parsers disagree" << std::endl;
+                    return 1;
+                }
+                parse_report << std::setw(10) << count << std::fixed << std::setprecision(1)
+                             << std::setw(16) << streams * 1000.0
+                             << std::setw(16) << views * 1000.0
+                             << std::setw(10) << streams / views << "x" << std::endl;
+            }
+
+            std::remove(filename.c_str());
+        }
+    }
+
+    std::cout << "\nText parsing only\n"
+              << std::setw(10) << "NPCs"
+              << std::setw(16) << "stream (ms)"
+              << std::setw(16) << "from_chars (ms)"
+              << std::setw(11) << "speedup" << std::endl
+              << parse_report.str();
+
+    return 0;
+}
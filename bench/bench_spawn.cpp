@@ -0,0 +1,85 @@
+#include "../include/factory.h"
+#include "../include/game_engine.h"
+#include "../include/rng.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Массовое создание NPC: прежний путь (фабрика и addNpc с блокировкой на
+// каждого NPC) против GameEngine::spawnNpcs для трёх распределений.
+// Аргумент - наибольшее число NPC (по умолчанию 10 000 000); прежний путь
+// меряется только до миллиона.
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double millis(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+// Прежний createRandomNpcs
+void legacySpawn(GameEngine& engine, size_t count, int width, int height) {
+    const NpcTypeId types[] = {NpcTypeId::Knight, NpcTypeId::Druid, NpcTypeId::Elf};
+    for (size_t i = 0; i < count; ++i) {
+        rng::CounterRng gen(engine.getSeed(), rng::Stream::Spawn, 0, i);
+        std::string type(npcTypeName(types[gen.uniform(0, 2)]));
+        std::string name = type + "_" + std::to_string(i);
+        int x = gen.uniform(0, width - 1);
+        int y = gen.uniform(0, height - 1);
+        engine.addNpc(NpcFactory::createNpc(type, name, x, y));
+    }
+}
+
+const char* distributionName(GameEngine::SpawnDistribution distribution) {
+    switch (distribution) {
+        case GameEngine::SpawnDistribution::Uniform: return "uniform";
+        case GameEngine::SpawnDistribution::Clustered: return "clustered";
+        case GameEngine::SpawnDistribution::Gaussian: return "gaussian";
+    }
+    return "";
+}
+
+}
+
+int main(int argc, char** argv) {
+    size_t max_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    const int kSide = 10000;
+
+    std::cout << std::setw(10) << "NPCs"
+              << std::setw(12) << "mode"
+              << std::setw(14) << "time (ms)"
+              << std::setw(16) << "NPCs/s (M)" << std::endl;
+
+    auto report = [](size_t count, const char* mode, double ms) {
+        std::cout << std::fixed << std::setprecision(1)
+                  << std::setw(10) << count
+                  << std::setw(12) << mode
+                  << std::setw(14) << ms
+                  << std::setw(16) << std::setprecision(2) << count / ms / 1000.0 << std::endl;
+    };
+
+    for (size_t count = 100000; count <= max_count; count *= 10) {
+        if (count <= 1000000) {
+            GameEngine engine(kSide, kSide);
+            engine.setSeed(1);
+            auto start = Clock::now();
+            legacySpawn(engine, count, kSide, kSide);
+            report(count, "legacy", millis(start, Clock::now()));
+        }
+
+        for (auto distribution : {GameEngine::SpawnDistribution::Uniform,
+                                  GameEngine::SpawnDistribution::Clustered,
+                                  GameEngine::SpawnDistribution::Gaussian}) {
+            GameEngine engine(kSide, kSide);
+            engine.setSeed(1);
+            GameEngine::SpawnConfig config;
+            config.distribution = distribution;
+            auto start = Clock::now();
+            engine.spawnNpcs(count, config);
+            report(count, distributionName(distribution), millis(start, Clock::now()));
+        }
+    }
+    return 0;
+}
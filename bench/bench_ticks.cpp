@@ -0,0 +1,58 @@
+#include "../include/game_engine.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+// Пропускная способность шагов без задержек: сценарий main (30 секунд
+// симуляции) при разном числе NPC, в обоих режимах выполнения.
+// Плотность NPC как в основной программе: 50 NPC на карте 100x100.
+namespace {
+
+GameEngine::RunStats runScenario(GameEngine::ExecutionMode mode, int count, int seconds) {
+    const double kDensity = 50.0 / (100.0 * 100.0);
+    int side = std::max(1, static_cast<int>(std::sqrt(count / kDensity)));
+
+    GameEngine engine(side, side);
+    engine.setExecutionMode(mode);
+    GameEngine::TickConfig config;
+    config.realtime = false;
+    config.display_every = 0;
+    engine.setTickConfig(config);
+    engine.createRandomNpcs(count);
+
+    std::ostringstream sink;
+    std::streambuf* original = std::cout.rdbuf(sink.rdbuf());
+    auto stats = engine.runTicks(static_cast<std::uint64_t>(seconds) * GameEngine::kTicksPerSecond);
+    std::cout.rdbuf(original);
+    return stats;
+}
+
+}
+
+int main() {
+    const int kCounts[] = {50, 1000, 10000};
+    const int kSeconds = 30;
+
+    std::cout << "Scenario: " << kSeconds << " s = " << kSeconds * GameEngine::kTicksPerSecond
+              << " ticks" << std::endl;
+    std::cout << std::setw(10) << "NPCs"
+              << std::setw(16) << "threaded (ms)"
+              << std::setw(14) << "ticks/s"
+              << std::setw(18) << "coroutines (ms)"
+              << std::setw(14) << "ticks/s" << std::endl;
+
+    for (int count : kCounts) {
+        auto threaded = runScenario(GameEngine::ExecutionMode::Threaded, count, kSeconds);
+        auto coroutines = runScenario(GameEngine::ExecutionMode::Coroutines, count, kSeconds);
+
+        std::cout << std::setw(10) << count << std::fixed << std::setprecision(1)
+                  << std::setw(16) << threaded.seconds * 1000.0
+                  << std::setw(14) << threaded.ticks_per_second
+                  << std::setw(18) << coroutines.seconds * 1000.0
+                  << std::setw(14) << coroutines.ticks_per_second << std::endl;
+    }
+
+    return 0;
+}
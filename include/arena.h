@@ -1,10 +1,15 @@
 #pragma once
 #include <string>
 #include "npc.h"
+#include <functional>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include "observer.h"
+#include "combat_visitor.h"
 #include <vector>
+#include <utility>
+#include <string_view>
 
 #define MAX_WIDTH 500
 #define MAX_HEIGHT 500
@@ -12,10 +17,32 @@
 
 class Arena {
     public:
-        Arena(int width = MAX_WIDTH, int height = MAX_HEIGHT);
+        // Алгоритм поиска пар для боя
+        enum class BattleMode {
+            BruteForce,     // перебор всех пар, O(n^2)
+            SweepAndPrune   // сортировка по оси X и проверка только пересекающихся интервалов
+        };
+
+        // Формат файла сценария
+        enum class FileFormat {
+            Text,   // строки "тип имя x y"
+            Binary  // колонки с заголовком, см. binary_scenario.h
+        };
+
+        // Загрузка файла: последовательная или пулом потоков
+        enum class LoadMode {
+            Serial,
+            Parallel
+        };
+
+        // memory - ресурс для NPC, создаваемых ареной, и узлов её словаря
+        // (например, пул или монотонная арена); должен пережить арену.
+        // nullptr - обычная куча.
+        Arena(int width = MAX_WIDTH, int height = MAX_HEIGHT,
+              std::pmr::memory_resource* memory = nullptr);
 
         // Добавление NPC на арену
-        void addNpc(std::unique_ptr<Npc> npc);
+        void addNpc(NpcPtr npc);
 
         void createAndAddNpc(const std::string& type, 
                          const std::string& name, 
@@ -35,21 +62,64 @@ class Arena {
         // Управление боем
         void startBattle(double range);
 
+        void setBattleMode(BattleMode mode);
+        BattleMode getBattleMode() const;
+
         // Сохранение в файл
-        void saveToFile(const std::string& filename) const;
+        void saveToFile(const std::string& filename, FileFormat format = FileFormat::Text) const;
 
-        // Загрузка из файла
+        // Загрузка из файла; формат определяется по сигнатуре в начале файла
         void loadFromFile(const std::string& filename);
 
+        // Параллельная загрузка делит файл на куски по границам строк, разбирает
+        // и проверяет их пулом из workers потоков (0 - по числу ядер), затем
+        // сливает в арену одной пачкой. Исключения те же, что у
+        // последовательной; при ошибке арена не меняется.
+        void setLoadMode(LoadMode mode, size_t workers = 0);
+        LoadMode getLoadMode() const;
+        size_t getLoadWorkerCount() const;
+
         // Очистка арены
         void clear();
+
+        std::pmr::memory_resource* getMemoryResource() const;
     
     private:
         int width_;
         int height_;
-        std::map<std::string, std::unique_ptr<Npc>> npcs_;
+        std::pmr::memory_resource* memory_;  // nullptr - куча
+        // Ключ - вид на имя внутри самого NPC: имя хранится один раз.
+        // Узел удаляется вместе с NPC, поэтому ключ не переживает строку.
+        std::pmr::map<std::string_view, NpcPtr, std::less<>> npcs_;
 
         std::vector<std::shared_ptr<Observer>> observers_;
 
-        void notifyObservers(const std::string& event);
+        BattleMode battle_mode_;
+
+        LoadMode load_mode_;
+        size_t load_workers_;
+
+        // Минимальный размер куска при параллельной загрузке
+        static constexpr size_t kLoadChunkBytes = 64 * 1024;
+
+        void notifyObservers(const BattleEvent& event);
+
+        bool inBounds(int x, int y) const;
+
+        void saveText(const std::string& filename) const;
+        void saveBinary(const std::string& filename) const;
+        void loadText(std::string_view data);
+        void loadBinary(std::string_view data);
+        void loadParallel(std::string_view data);
+
+        // Вставка при загрузке; дубликат имени - std::invalid_argument
+        void emplaceSorted(NpcPtr npc);
+
+        // Пары (name1 < name2) в пределах дальности боя
+        std::vector<std::pair<Npc*, Npc*>> findPairsBruteForce(double range) const;
+        std::vector<std::pair<Npc*, Npc*>> findPairsSweepAndPrune(double range) const;
+
+        // Бой одной пары, имена убитых добавляются в toRemove
+        void resolvePair(Npc* npc1, Npc* npc2, CombatVisitor& visitor,
+                         std::vector<std::string_view>& toRemove);
 };
\ No newline at end of file
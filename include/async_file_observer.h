@@ -0,0 +1,80 @@
+#pragma once
+#include "mpmc_queue.h"
+#include "observer.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Асинхронный наблюдатель с записью в файл.
+// Файл открывается один раз; notify только кладёт строку в ограниченную
+// lock-free очередь (MpmcQueue), а фоновый поток пишет накопленные события
+// одним блоком, когда их набралось flush_size или прошло flush_interval.
+// Память ограничена ёмкостью очереди: при переполнении notify ждёт писателя
+// (Overflow::Block) или отбрасывает событие (Overflow::Drop).
+// Деструктор дописывает все принятые события.
+class AsyncFileObserver : public Observer {
+    public:
+        enum class Overflow {
+            Block,
+            Drop
+        };
+
+        struct Config {
+            size_t capacity = 8192;  // событий в очереди (округляется до степени двойки)
+            size_t flush_size = 1024;
+            std::chrono::milliseconds flush_interval{100};
+            Overflow overflow = Overflow::Block;
+        };
+
+        explicit AsyncFileObserver(const std::string& filename);
+        AsyncFileObserver(const std::string& filename, const Config& config);
+        ~AsyncFileObserver() override;
+
+        AsyncFileObserver(const AsyncFileObserver&) = delete;
+        AsyncFileObserver& operator=(const AsyncFileObserver&) = delete;
+
+        void notify(const std::string& event) override;
+
+        // Ждёт, пока все события, принятые до вызова, окажутся в файле
+        void flush();
+
+        const Config& getConfig() const;
+        std::uint64_t getWritten() const;  // событий записано в файл
+        std::uint64_t getDropped() const;  // событий отброшено (Overflow::Drop)
+        std::uint64_t getBatches() const;  // блоков записи
+
+    private:
+        Config config_;
+        std::ofstream file_;
+        MpmcQueue<std::string> queue_;
+
+        std::atomic<std::uint64_t> accepted_;
+        std::atomic<std::uint64_t> written_;
+        std::atomic<std::uint64_t> dropped_;
+        std::atomic<std::uint64_t> batches_;
+        std::atomic<bool> kick_;  // набралось flush_size, писатель уже разбужен
+
+        // Холодный путь: пробуждение писателя и ожидание flush
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable flushed_;
+        std::uint64_t flush_target_;  // сколько событий должно быть записано
+        bool stopping_;
+
+        // Только для потока записи
+        std::vector<std::string> batch_;
+        std::string buffer_;
+
+        std::thread thread_;
+
+        void wakeWriter();
+        void run();
+        void writeUntil(std::uint64_t target);
+};
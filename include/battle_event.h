@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+
+class Npc;
+
+// Событие боя арены без готового текста.
+// Указатели действительны только во время уведомления: убитые NPC удаляются
+// из арены после боя. Текст собирается при первом запросе и один раз на
+// событие, сколько бы строковых наблюдателей его ни читало.
+struct BattleEvent {
+    enum class Kind {
+        Kill,        // attacker убил defender
+        MutualKill   // attacker и defender убили друг друга
+    };
+
+    Kind kind;
+    const Npc* attacker;
+    const Npc* defender;
+
+    BattleEvent(Kind kind, const Npc* attacker, const Npc* defender)
+        : kind(kind), attacker(attacker), defender(defender) {}
+
+    // Текст прежнего строкового API: "A (Type) killed B (Type)"
+    const std::string& text() const;
+
+    // Дописывает тот же текст в out без промежуточных строк
+    void appendTo(std::string& out) const;
+
+    private:
+        mutable std::string text_;
+};
@@ -0,0 +1,90 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "npc_type.h"
+
+// Двоичный формат сценария арены (версия 1).
+//
+// Файл состоит из заголовка и колонок, каждая начинается с границы 8 байт:
+//   BinaryScenarioHeader
+//   types        - count x uint8 (NpcTypeId)
+//   coords       - count x {int32 x, int32 y}
+//   name_offsets - (count + 1) x uint64, смещения имён в таблице строк
+//   names        - имена подряд, без разделителей
+// Числа записываются в порядке байт машины; byte_order позволяет отличить
+// файл с другой машины. Загрузка читает колонки прямо из отображения файла.
+namespace binary_scenario {
+
+inline constexpr char kMagic[8] = {'N', 'P', 'C', 'A', 'R', 'E', 'N', 'A'};
+inline constexpr std::uint32_t kVersion = 1;
+inline constexpr std::uint32_t kByteOrderMark = 0x01020304;
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t count;
+    std::uint64_t types_offset;
+    std::uint64_t coords_offset;
+    std::uint64_t name_offsets_offset;
+    std::uint64_t names_offset;
+    std::uint64_t names_size;
+};
+static_assert(sizeof(Header) == 64, "Header layout is part of the file format");
+
+struct Coord {
+    std::int32_t x;
+    std::int32_t y;
+};
+
+// Колонки для записи; имена ссылаются на строки вызывающего
+struct Columns {
+    std::vector<NpcTypeId> types;
+    std::vector<Coord> coords;
+    std::vector<std::string_view> names;
+};
+
+// Начинается ли буфер с сигнатуры двоичного формата
+bool hasMagic(std::string_view data);
+
+// Запись файла, бросает std::runtime_error при ошибке открытия или записи
+void write(const std::string& filename, const Columns& columns);
+
+// Представление колонок поверх буфера файла (обычно MappedFile).
+// Конструктор проверяет заголовок и границы колонок и бросает
+// std::runtime_error для повреждённого или несовместимого файла.
+class View {
+    public:
+        explicit View(std::string_view data);
+
+        size_t size() const { return count_; }
+
+        NpcTypeId type(size_t i) const {
+            return static_cast<NpcTypeId>(static_cast<std::uint8_t>(types_[i]));
+        }
+
+        Coord coord(size_t i) const {
+            Coord result;
+            std::memcpy(&result, coords_ + i * sizeof(Coord), sizeof(Coord));
+            return result;
+        }
+
+        std::string_view name(size_t i) const {
+            std::uint64_t range[2];
+            std::memcpy(range, name_offsets_ + i * sizeof(std::uint64_t), sizeof(range));
+            return {names_ + range[0], static_cast<size_t>(range[1] - range[0])};
+        }
+
+    private:
+        size_t count_;
+        const char* types_;
+        const char* coords_;
+        const char* name_offsets_;
+        const char* names_;
+};
+
+}
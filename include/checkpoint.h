@@ -0,0 +1,127 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "npc_type.h"
+#include "world_snapshot.h"
+
+// Контрольные точки симуляции GameEngine (версия формата 1).
+//
+// Полная точка хранит весь мир из WorldSnapshot: заголовок, колонки типов,
+// флагов жизни, координат и таблицу имён (как в binary_scenario.h).
+// Разностная точка хранит только NPC, у которых с базовой точки изменились
+// координаты или флаг жизни: записи {индекс, x, y, alive}. Восстановление -
+// полная точка и идущие за ней разностные, каждая от предыдущей.
+namespace checkpoint {
+
+inline constexpr char kMagic[8] = {'N', 'P', 'C', 'C', 'H', 'K', 'P', 'T'};
+inline constexpr std::uint32_t kVersion = 1;
+inline constexpr std::uint32_t kByteOrderMark = 0x01020304;
+
+enum class Kind : std::uint32_t {
+    Full = 0,
+    Delta = 1
+};
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    Kind kind;
+    std::int32_t width;
+    std::int32_t height;
+    std::uint32_t reserved;
+    std::uint64_t tick;       // шаг, после которого снята точка
+    std::uint64_t base_tick;  // для разностной - шаг базовой точки
+    std::uint64_t seed;
+    std::uint64_t count;      // NPC в мире
+    std::uint64_t records;    // записей в файле (count для полной)
+    std::uint64_t names_size;
+};
+static_assert(sizeof(Header) == 80, "Header layout is part of the file format");
+
+struct DeltaRecord {
+    std::uint32_t index;
+    std::int32_t x;
+    std::int32_t y;
+    std::uint32_t alive;
+};
+
+// Состояние мира, восстановленное из цепочки точек
+struct State {
+    std::uint64_t tick = 0;
+    std::uint64_t seed = 0;
+    int width = 0;
+    int height = 0;
+    std::vector<NpcTypeId> types;
+    std::vector<int> xs;
+    std::vector<int> ys;
+    std::vector<std::uint8_t> alive;
+    std::vector<std::string> names;
+};
+
+// Запись полной точки, или разностной, если base задан и размер мира
+// не менялся. Файл пишется как <filename>.tmp и переименовывается после
+// записи, поэтому под именем точки не бывает обрезанного файла.
+// Бросает std::runtime_error при ошибке записи.
+void write(const std::string& filename, const WorldSnapshot& snapshot,
+           const WorldSnapshot* base, std::uint64_t seed);
+
+// Чтение цепочки: полная точка, затем разностные по порядку.
+// Бросает std::runtime_error для повреждённого файла или разрыва цепочки.
+State load(const std::vector<std::string>& files);
+
+// Цепочка для самой поздней точки среди файлов <prefix>-*.ckpt (имена
+// периодических точек CheckpointConfig): звенья находятся по шагу и
+// base_tick заголовков, без памяти записавшего их процесса. Пустой
+// список, если полной цепочки нет.
+std::vector<std::string> findChain(const std::string& prefix);
+
+// Фоновая запись точек. submit возвращает сразу: снимок неизменяем,
+// поэтому симуляция продолжает шаги, пока поток записи сериализует его.
+class Writer {
+    public:
+        Writer();
+        ~Writer();  // дописывает очередь
+
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+
+        void submit(const std::string& filename,
+                    std::shared_ptr<const WorldSnapshot> snapshot,
+                    std::shared_ptr<const WorldSnapshot> base,
+                    std::uint64_t seed);
+
+        // Ждёт записи всех поставленных точек; пробрасывает первую ошибку
+        void wait();
+
+        std::uint64_t getWritten() const;
+
+    private:
+        struct Job {
+            std::string filename;
+            std::shared_ptr<const WorldSnapshot> snapshot;
+            std::shared_ptr<const WorldSnapshot> base;
+            std::uint64_t seed;
+        };
+
+        mutable std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable idle_;
+        std::deque<Job> jobs_;
+        bool busy_;
+        bool stopping_;
+        std::uint64_t written_;
+        std::exception_ptr error_;
+        std::thread thread_;
+
+        void run();
+};
+
+}
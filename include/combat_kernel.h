@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "combat_rules.h"
+#include "npc_type.h"
+
+// Пакетная проверка пар "NPC против блока NPC".
+// Блок задаётся столбцами SoA (x, y, type_id, alive). Вместо sqrt сравниваются
+// квадраты расстояний с квадратом большей из двух дальностей атаки, затем
+// применяется маска "кто кого убивает" из CombatRules.
+//
+// Реализация выбирается при первом вызове: AVX2 (8 пар за шаг), если процессор
+// его поддерживает, иначе скалярная. Разность координат в паре должна быть
+// меньше 32768 по каждой оси, иначе квадрат расстояния не помещается в int32.
+namespace combat_kernel {
+
+enum class Impl {
+    Scalar,
+    Avx2
+};
+
+// Строка для проверки: один NPC и блок партнёров
+struct Probe {
+    int x;
+    int y;
+    NpcTypeId type;
+};
+
+struct Block {
+    const int* xs;
+    const int* ys;
+    const NpcTypeId* types;
+    const std::uint8_t* alive;
+    size_t count;
+};
+
+// Таблицы правил в виде, удобном для векторных gather-инструкций:
+// квадрат дальности атаки и маска жертв для каждого слота CombatRules
+struct Tables {
+    alignas(32) std::int32_t kill_radius_sq[CombatRules::kMaxTypes];
+    alignas(32) std::int32_t kill_mask[CombatRules::kMaxTypes];
+};
+
+Tables makeTables(const CombatRules& rules);
+
+// Записывает в hits индексы блока, образующие с probe боевую пару
+// (в зоне досягаемости и хотя бы один может убить другого).
+// hits должен вмещать block.count элементов. Возвращает число найденных.
+size_t findHits(const Probe& probe, const Block& block, const Tables& tables,
+                std::uint32_t* hits);
+
+// Текущая реализация и её принудительная смена (для тестов и бенчмарков).
+// Запрос Avx2 на процессоре без AVX2 оставляет скалярную версию.
+Impl getImpl();
+void setImpl(Impl impl);
+bool isAvx2Supported();
+
+}
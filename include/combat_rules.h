@@ -0,0 +1,111 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include "npc_type.h"
+
+// Дальность перемещения и атаки типа NPC
+struct NpcStats {
+    int movement_distance;
+    int kill_distance;
+};
+
+// Таблица правил боя, индексируемая NpcTypeId.
+// "Кто кого убивает" хранится битовыми масками: бит d в маске атакующего a
+// означает, что a убивает d. Поиск в паре - один сдвиг без ветвлений.
+class CombatRules {
+    public:
+        // Размер таблиц. Последний слот всегда пустой: в него попадает
+        // NpcTypeId::Unknown после маскирования индекса.
+        static constexpr std::size_t kMaxTypes = 16;
+        static constexpr std::size_t kIndexMask = kMaxTypes - 1;
+
+        using KillMask = std::uint16_t;
+
+        constexpr CombatRules() : kill_masks_{}, stats_{} {}
+
+        constexpr bool canKill(NpcTypeId attacker, NpcTypeId defender) const {
+            return (kill_masks_[slot(attacker)] >> slot(defender)) & 1u;
+        }
+
+        // Маска всех типов, которых убивает attacker
+        constexpr KillMask getKillMask(NpcTypeId attacker) const {
+            return kill_masks_[slot(attacker)];
+        }
+
+        constexpr const NpcStats& getStats(NpcTypeId type) const {
+            return stats_[slot(type)];
+        }
+
+        // Максимальная дальность атаки среди всех типов
+        constexpr int maxKillDistance() const {
+            int result = 0;
+            for (const auto& stats : stats_) {
+                result = stats.kill_distance > result ? stats.kill_distance : result;
+            }
+            return result;
+        }
+
+        constexpr void setKills(NpcTypeId attacker, NpcTypeId defender, bool kills) {
+            KillMask bit = static_cast<KillMask>(1u << checkedSlot(defender));
+            KillMask& mask = kill_masks_[checkedSlot(attacker)];
+            mask = kills ? static_cast<KillMask>(mask | bit) : static_cast<KillMask>(mask & ~bit);
+        }
+
+        constexpr void setStats(NpcTypeId type, NpcStats stats) {
+            stats_[checkedSlot(type)] = stats;
+        }
+
+        // Правила варианта 11, вычисляются на этапе компиляции
+        static constexpr CombatRules defaults() {
+            CombatRules rules;
+            rules.setStats(NpcTypeId::Knight, {30, 10});
+            rules.setStats(NpcTypeId::Druid, {10, 10});
+            rules.setStats(NpcTypeId::Elf, {10, 50});
+
+            rules.setKills(NpcTypeId::Knight, NpcTypeId::Elf, true);
+            rules.setKills(NpcTypeId::Druid, NpcTypeId::Druid, true);
+            rules.setKills(NpcTypeId::Elf, NpcTypeId::Druid, true);
+            rules.setKills(NpcTypeId::Elf, NpcTypeId::Knight, true);
+            return rules;
+        }
+
+        // Загрузка правил из текстового файла. Формат строк:
+        //   stats <Type> <movement_distance> <kill_distance>
+        //   kills <Attacker> <Defender> [<Defender> ...]
+        // Пустые строки и строки с '#' игнорируются. Файл описывает правила
+        // полностью: не упомянутые пары не сражаются.
+        static CombatRules loadFromFile(const std::string& filename);
+
+        // Правила, действующие в процессе. Меняются только при старте,
+        // до создания GameEngine / запуска боёв.
+        static const CombatRules& active();
+        static void setActive(const CombatRules& rules);
+
+    private:
+        std::array<KillMask, kMaxTypes> kill_masks_;
+        std::array<NpcStats, kMaxTypes> stats_;
+
+        static constexpr std::size_t slot(NpcTypeId type) {
+            return toIndex(type) & kIndexMask;
+        }
+
+        static constexpr std::size_t checkedSlot(NpcTypeId type) {
+            if (toIndex(type) >= kIndexMask) {
+                throw std::out_of_range("NPC type id does not fit rule table.");
+            }
+            return toIndex(type);
+        }
+};
+
+inline constexpr CombatRules kDefaultCombatRules = CombatRules::defaults();
+
+// Правило по умолчанию как константа времени компиляции для шаблонов
+template <NpcTypeId Attacker, NpcTypeId Defender>
+inline constexpr bool kCanKill = kDefaultCombatRules.canKill(Attacker, Defender);
+
+static_assert(kNpcTypeCount < CombatRules::kIndexMask, "Too many NPC types for rule table");
+static_assert(kCanKill<NpcTypeId::Elf, NpcTypeId::Knight>);
+static_assert(!kCanKill<NpcTypeId::Knight, NpcTypeId::Druid>);
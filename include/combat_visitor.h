@@ -5,13 +5,10 @@
 class CombatVisitor : public Visitor {
     public:
         bool canKill(Npc* attacker, Npc* defender);
+        bool canKill(NpcTypeId attacker, NpcTypeId defender);
+        bool canKill(const std::string& attackerType, const std::string& defenderType);
 
         void visit(Knight&) override {}
         void visit(Druid&) override {}
         void visit(Elf&) override {}
-
-    private:
-        bool knightVs(const std::string& defenderType);
-        bool druidVs(const std::string& defenderType);
-        bool elfVs(const std::string& defenderType);
 };
\ No newline at end of file
@@ -1,10 +1,40 @@
 #pragma once
+#include "event_sink.h"
 #include "observer.h"
-#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
 
+// События пишутся через общий журнал (EventSink): notify только копирует
+// строку в буфер потока, вывод в консоль идёт пачками из потока журнала
 class ConsoleObserver : public Observer {
     public:
+        ConsoleObserver() : ConsoleObserver(EventSink::console()) {}
+
+        explicit ConsoleObserver(std::shared_ptr<EventSink> sink)
+            : sink_(std::move(sink)), source_(sink_->addSource(format)) {}
+
+        // Дожидается вывода своих событий
+        ~ConsoleObserver() override {
+            sink_->removeSource(source_);
+        }
+
         void notify(const std::string& event) override {
-            std::cout << "[BATTLE] " << event << std::endl;
+            sink_->pushText(event, source_);
+        }
+
+        void onBattleEnd() override {
+            sink_->flush();
+        }
+
+    private:
+        std::shared_ptr<EventSink> sink_;
+        std::uint32_t source_;
+
+        static void format(const EventRecord&, std::string_view text, std::string& out) {
+            out += "[BATTLE] ";
+            out += text;
+            out += '\n';
         }
-};
\ No newline at end of file
+};
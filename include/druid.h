@@ -9,8 +9,5 @@ class Druid : public Npc {
         void accept(Visitor& visitor) override;
 
         void printInfo() const override;
-
-    private:
-        static const std::string kType;
 };
 
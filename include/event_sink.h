@@ -0,0 +1,121 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+enum class EventKind : std::uint16_t {
+    Kill,  // attacker убил defender
+    Text   // готовая строка: attacker - смещение, defender - длина в буфере потока
+};
+
+// Запись события фиксированного размера. Имена не копируются: источник
+// (source) при выводе сам превращает номера в текст.
+struct EventRecord {
+    std::uint64_t tick;
+    std::uint32_t attacker;
+    std::uint32_t defender;
+    std::uint32_t source;
+    EventKind kind;
+};
+
+static_assert(sizeof(EventRecord) == 24, "EventRecord must stay compact");
+
+// Общий журнал событий.
+// Производители кладут записи в буфер своего потока (копирование 24 байт
+// под свободной спин-блокировкой), единственный поток-потребитель забирает
+// буферы целиком, форматирует записи через функции источников и пишет
+// в поток вывода одним write. Буфер потока ограничен: при заполнении
+// производитель ждёт потребителя. Порядок записей сохраняется в пределах
+// одного потока-производителя.
+class EventSink {
+    public:
+        // Дописывает в out строку события вместе с '\n'; text - строка
+        // записи EventKind::Text, для остальных пустая
+        using Formatter = std::function<void(const EventRecord& record, std::string_view text,
+                                             std::string& out)>;
+
+        struct Config {
+            size_t records_per_thread = 4096;
+            size_t text_per_thread = 256 * 1024;  // байт строк в буфере потока
+            std::chrono::milliseconds flush_interval{50};
+        };
+
+        // Источник 0: строки EventKind::Text выводятся как есть
+        static constexpr std::uint32_t kPlainText = 0;
+
+        explicit EventSink(std::ostream& out);
+        EventSink(std::ostream& out, const Config& config);
+        ~EventSink();  // дописывает все записи
+
+        EventSink(const EventSink&) = delete;
+        EventSink& operator=(const EventSink&) = delete;
+
+        // Общий журнал в std::cout
+        static std::shared_ptr<EventSink> console();
+
+        std::uint32_t addSource(Formatter formatter);
+
+        // Дописывает записи источника и отключает его; записи, пришедшие
+        // позже, пропускаются
+        void removeSource(std::uint32_t source);
+
+        void push(const EventRecord& record);
+        void pushText(std::string_view text, std::uint32_t source = kPlainText,
+                      std::uint64_t tick = 0);
+
+        // Ждёт, пока все записи, сделанные до вызова, окажутся в потоке вывода
+        void flush();
+
+        std::uint64_t getWritten() const;  // выведено записей
+
+    private:
+        struct ThreadBuffer {
+            std::atomic_flag busy = ATOMIC_FLAG_INIT;
+            std::vector<EventRecord> records;
+            std::string text;
+        };
+
+        std::ostream& out_;
+        Config config_;
+        std::uint64_t id_;  // ключ буферов потоков; номера не переиспользуются
+
+        std::mutex buffers_mutex_;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+
+        std::mutex sources_mutex_;
+        std::vector<Formatter> sources_;
+
+        std::atomic<std::uint64_t> written_;
+
+        // Пробуждение потребителя и ожидание flush
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable flushed_;
+        bool kick_;
+        bool stopping_;
+        std::uint64_t flush_requested_;
+        std::uint64_t flush_done_;
+
+        // Только для потребителя
+        std::vector<EventRecord> spare_records_;
+        std::string spare_text_;
+        std::string output_;
+
+        std::thread thread_;
+
+        ThreadBuffer& localBuffer();
+        ThreadBuffer& lockBuffer(size_t records, size_t text);
+        void wakeConsumer();
+        void run();
+        void drain();
+};
@@ -1,18 +1,34 @@
 #pragma once
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include "npc.h"
 
+// NPC создаются в куче или, если передан memory, в памяти этого
+// std::pmr::memory_resource (пул, монотонная арена). Ресурс должен пережить
+// созданные NPC; фабрика обращается к нему без блокировок, поэтому потокобезопасность
+// ресурса - забота вызывающего.
 class NpcFactory {
 public:
     // Создание NPC по типу
-    static std::unique_ptr<Npc> createNpc(
+    static NpcPtr createNpc(
         const std::string& type,
         const std::string& name,
         int x, 
-        int y
+        int y,
+        std::pmr::memory_resource* memory = nullptr
     );
     
+    // Создание NPC по идентификатору типа (без сравнения строк)
+    static NpcPtr createNpc(
+        NpcTypeId type,
+        const std::string& name,
+        int x,
+        int y,
+        std::pmr::memory_resource* memory = nullptr
+    );
+
     // Загрузка из строки файла
-    static std::unique_ptr<Npc> createFromString(const std::string& line);
+    static NpcPtr createFromString(const std::string& line,
+                                   std::pmr::memory_resource* memory = nullptr);
 };
\ No newline at end of file
@@ -1,79 +1,406 @@
 #pragma once
 #include <vector>
-#include <map>
 #include <memory>
-#include <thread>
+#include <memory_resource>
 #include <mutex>
 #include <shared_mutex>
-#include <condition_variable>
-#include <queue>
 #include <atomic>
+#include <unordered_set>
 #include <chrono>
 #include "npc.h"
-#include "combat_visitor.h"
+#include "combat_rules.h"
+#include "combat_kernel.h"
+#include "spatial_grid.h"
+#include "world_store.h"
+#include "mpmc_queue.h"
+#include "thread_pool.h"
+#include "tick_scheduler.h"
+#include "rng.h"
+#include "world_snapshot.h"
+#include "map_renderer.h"
+#include "checkpoint.h"
+#include "event_sink.h"
 
+// Пара для боя - индексы NPC в хранилище мира. Индекс имени не меняется
+// (замена по имени пишет в тот же слот), поэтому задача не копирует строк,
+// а бой не ищет участников по имени. Имя - WorldSnapshot::getName(npc1).
 struct MovementTask {
-    std::string npc1_name;
-    std::string npc2_name;
+    WorldStore::Index npc1;
+    WorldStore::Index npc2;
 };
 
 class GameEngine {
     public:
-        GameEngine(int width = 100, int height = 100);
+        // Способ поиска пар для боя
+        enum class DetectionMode {
+            BruteForce,  // перебор всех пар, O(n^2)
+            Grid         // только соседние ячейки пространственной сетки
+        };
+
+        // Способ выполнения шага
+        enum class ExecutionMode {
+            Threaded,    // фазы делятся на задачи пула потоков
+            Coroutines   // корутины пачек NPC в одном потоке, без блокировок
+        };
+
+        // memory - ресурс для объектов Npc, создаваемых движком (createRandomNpcs,
+        // resumeFromCheckpoint), например пул или монотонная арена; должен
+        // пережить движок. nullptr - обычная куча.
+        GameEngine(int width = 100, int height = 100, std::pmr::memory_resource* memory = nullptr);
         ~GameEngine();
 
         // Добавление NPC
-        void addNpc(std::unique_ptr<Npc> npc);
+        void addNpc(NpcPtr npc);
+
+        // Распределение позиций при массовом создании NPC
+        enum class SpawnDistribution {
+            Uniform,    // равномерно по карте
+            Clustered,  // равномерно в квадратах вокруг случайных центров
+            Gaussian    // нормально вокруг случайных центров
+        };
+
+        struct SpawnConfig {
+            SpawnDistribution distribution = SpawnDistribution::Uniform;
+            int clusters = 8;      // число центров скоплений
+            double spread = 0.05;  // полуширина квадрата / сигма в долях меньшей стороны карты
+        };
+
+        // Массовое создание NPC с именами <Тип>_<номер в вызове>. Типы и
+        // позиции генерируются пулом потоков из потока Spawn (результат не
+        // зависит от числа потоков); весь вызов - под одной эксклюзивной
+        // блокировкой мира.
+        // Объекты Npc таких NPC создаются только для вывода выживших.
+        // Занятое имя заменяет прежнего NPC, как в addNpc.
+        void spawnNpcs(size_t count, const SpawnConfig& config);
+        void spawnNpcs(size_t count);  // равномерно
+
+        // То же, что spawnNpcs(count)
         void createRandomNpcs(int count);
 
-        // Запуск симуляции на N секунд
+        // Фиксированный шаг: одна секунда симуляции - kTicksPerSecond шагов
+        static constexpr std::uint64_t kTicksPerSecond = 10;
+
+        // Темп прогона шагов
+        struct TickConfig {
+            bool realtime = true;               // false - шаги без задержек (headless)
+            double ticks_per_second = 10.0;     // частота шагов в реальном времени
+            std::uint64_t display_every = 10;   // карта раз в N шагов, 0 - без карты
+        };
+
+        void setTickConfig(const TickConfig& config);
+        TickConfig getTickConfig() const;
+
+        // Итог прогона шагов
+        struct RunStats {
+            std::uint64_t ticks;
+            double seconds;                // реальное время прогона
+            double ticks_per_second;
+            std::uint64_t late_ticks;      // шаги, начатые позже расписания
+        };
+
+        // Запуск симуляции на N секунд симуляции (N * kTicksPerSecond шагов)
+        // с заголовком и списком выживших
         void runSimulation(int durationSeconds);
 
-        // Получить информацию о выживших
+        // Прогон N шагов в темпе TickConfig
+        RunStats runTicks(std::uint64_t ticks);
+
+        // Один шаг симуляции без задержек: движение, поиск боёв, бои.
+        // Каждая фаза делится на куски и выполняется пулом потоков.
+        void step();
+
+        // Число выполненных шагов
+        std::uint64_t getTick() const;
+
+        // Получить информацию о выживших (по последнему снимку)
         std::vector<std::string> getSurvivors() const;
 
-        // Печать карты
+        // Печать карты (по последнему снимку)
         void printMap() const;
 
+        // Full - каждый кадр целиком, Diff - только изменённые клетки через
+        // ANSI-последовательности (для терминала)
+        void setRenderMode(MapRenderer::Mode mode);
+        MapRenderer::Mode getRenderMode() const;
+
+        // Последний опубликованный снимок мира. Публикуется после каждого шага;
+        // после addNpc пересобирается при первом чтении. Чтение во время
+        // шагов не берёт блокировок мира.
+        std::shared_ptr<const WorldSnapshot> getSnapshot() const;
+
+        // Выбор алгоритма поиска боёв
+        void setDetectionMode(DetectionMode mode);
+        DetectionMode getDetectionMode() const;
+
+        // Все пары живых NPC в зоне боя, готовые к постановке в очередь
+        std::vector<MovementTask> findCombatPairs() const;
+
+        // Счётчики конвейера боёв
+        struct CombatStats {
+            QueueStats queue;                  // глубина очереди, переполнения
+            std::uint64_t duplicates_dropped;  // повторы пар: найденные дважды за проход
+                                               // или уже ожидавшие в очереди
+            size_t pending_pairs;              // пар в очереди сейчас
+        };
+
+        CombatStats getCombatStats() const;
+
+        // Один проход поиска боёв с постановкой новых пар в очередь; пара,
+        // ещё ожидающая в очереди с прошлых вызовов, повторно не ставится.
+        // Если очередь заполнена, стоящие в ней бои проводятся сразу.
+        void detectAndQueueCombats();
+
+        // Число рабочих потоков пула (по умолчанию число ядер, минимум 1).
+        // Нельзя менять во время runSimulation / step.
+        void setWorkerCount(size_t count);
+        size_t getWorkerCount() const;
+
+        // Зерно генератора случайных чисел. При одном зерне и одинаковых
+        // вызовах симуляция повторяется при любом числе потоков и режиме.
+        // По умолчанию выбирается случайно при создании движка.
+        void setSeed(std::uint64_t seed);
+        std::uint64_t getSeed() const;
+
+        // Режим выполнения шага. В режиме Coroutines движок однопоточный:
+        // step/runSimulation нельзя вызывать параллельно с другими методами.
+        void setExecutionMode(ExecutionMode mode);
+        ExecutionMode getExecutionMode() const;
+
+        // Контрольные точки снимаются с последнего опубликованного снимка и
+        // пишутся фоновым потоком: шаги симуляции запись не ждут
+        struct CheckpointConfig {
+            std::string prefix;             // файлы prefix-<шаг>.ckpt
+            std::uint64_t every_ticks = 0;  // период в runTicks, 0 - выключено
+            bool delta = false;             // между полными - только изменения
+            std::uint64_t full_every = 10;  // длина цепочки до следующей полной
+        };
+
+        void setCheckpointConfig(const CheckpointConfig& config);
+        CheckpointConfig getCheckpointConfig() const;
+
+        // Поставить точку в очередь записи. delta - только NPC, изменившиеся
+        // с прошлой точки этого движка; после addNpc точка всегда полная.
+        void checkpoint(const std::string& filename, bool delta = false);
+
+        // Дождаться записи всех точек; пробрасывает ошибку записи
+        void waitForCheckpoints();
+
+        // Файлы для восстановления последней точки: полная и разностные после неё.
+        // После перезапуска цепочку по файлам находит checkpoint::findChain(prefix).
+        std::vector<std::string> getCheckpointChain() const;
+
+        // Восстановить NPC, шаг и зерно из цепочки точек (размер карты должен
+        // совпадать). Продолжение повторяет непрерывный прогон шаг в шаг.
+        // Нельзя вызывать во время step / runTicks.
+        void resumeFromCheckpoint(const std::vector<std::string>& files);
+
+        std::pmr::memory_resource* getMemoryResource() const;
+
+        // Журнал сообщений [COMBAT], по умолчанию общий журнал консоли.
+        // Бой только кладёт запись (индексы NPC и шаг) в буфер потока, имена
+        // подставляет поток журнала. Нельзя менять во время step / runTicks.
+        void setEventSink(std::shared_ptr<EventSink> sink);
+        std::shared_ptr<EventSink> getEventSink() const;
+
+        // Дождаться вывода всех сообщений боёв (runTicks и printMap делают
+        // это сами; после step вывод идёт в фоне)
+        void flushEvents() const;
+
     private:
         int width_;
         int height_;
+        std::pmr::memory_resource* memory_;  // для объектов Npc; nullptr - куча
 
         // Синхронизация доступа
         mutable std::shared_mutex npcs_mutex_;
         mutable std::mutex cout_mutex_;
-        std::mutex movement_queue_mutex_;
 
-        // Хранилище NPC
-        std::map<std::string, std::unique_ptr<Npc>> npcs_;
+        // Хранилище NPC: данные симуляции лежат в WorldStore (SoA),
+        // объекты Npc остаются фасадом и синхронизируются по запросу.
+        // Индекс в npc_objects_ совпадает с индексом в world_; у NPC из
+        // spawnNpcs объект пустой, пока не понадобится.
+        WorldStore world_;
+        std::vector<NpcPtr> npc_objects_;
 
-        // Очередь боевых задач
-        std::queue<MovementTask> movement_tasks_;
+        // Правила боя и таблица скоростей, копия CombatRules::active()
+        // на момент создания движка
+        CombatRules rules_;
+        combat_kernel::Tables kernel_tables_;
 
-        // Флаг для остановки потоков
-        std::atomic<bool> running_;
+        // Пространственный индекс живых NPC (под защитой npcs_mutex_)
+        SpatialGrid grid_;
+        // Позиции до шага движения для обновления сетки; память
+        // переиспользуется между шагами
+        std::vector<int> old_xs_;
+        std::vector<int> old_ys_;
+        // Номер последней пачки боёв каждого NPC для colourPairs (0 - не
+        // участвовал); после раскладки снова обнуляется
+        std::vector<std::uint32_t> combat_batch_;
+        std::atomic<DetectionMode> detection_mode_;
 
-        // Потоки
-        std::thread movement_thread_;
-        std::thread combat_thread_;
-        std::thread display_thread_;
+        // Очередь боевых задач: фаза поиска пишет, фаза боёв
+        // разбирает её пачками параллельно. Пары не теряются: заполнив
+        // очередь, поиск сам проводит стоящие в ней бои (queue.dropped -
+        // сколько раз очередь оказывалась полной)
+        static constexpr size_t kCombatQueueCapacity = 1 << 16;
+        static constexpr size_t kCombatBatchSize = 256;
+        MpmcQueue<MovementTask> combat_queue_;
 
-        // Методы для потоков
-        void movementThreadFunc();
-        void combatThreadFunc();
-        void displayThreadFunc();
+        // Пары, поставленные detectAndQueueCombats (ключ - pairKey). Не даёт
+        // ставить одну и ту же пару повторно, пока фаза боёв её не обработала.
+        // step() множество не трогает: к поиску очередь шага пуста, а повторы
+        // убирает detectCombats.
+        // Порядок блокировок: npcs_mutex_, затем pending_mutex_.
+        mutable std::mutex pending_mutex_;
+        std::unordered_set<std::uint64_t> pending_pairs_;
+        std::atomic<std::uint64_t> duplicates_dropped_;
 
-        // Таблица скоростей и дальностей атаки
-        struct NpcStats {
-            int movement_distance;
-            int kill_distance;
-        };
+        // Пул с кражей работы, создаётся при первом использовании
+        mutable std::mutex pool_mutex_;
+        mutable std::unique_ptr<ThreadPool> pool_;
+        size_t worker_count_;
+
+        // Минимальный размер куска NPC / строк сетки / боёв для одной задачи пула
+        static constexpr size_t kSpawnGrain = 16384;
+        static constexpr size_t kMovementGrain = 4096;
+        static constexpr size_t kDetectionGrain = 1;
+        static constexpr size_t kCombatGrain = 256;
+
+        std::uint64_t seed_;
+
+        // Однопоточный режим: корутина на каждую пачку NPC и корутина боёв.
+        // Пересоздаются, когда меняется число NPC.
+        static constexpr size_t kCoroutineBatch = 256;
+        ExecutionMode execution_mode_;
+        TickScheduler scheduler_;
+        size_t scheduled_npcs_;
 
-        NpcStats getStats(const std::string& type) const;
+        TickConfig tick_config_;
+        std::atomic<std::uint64_t> tick_;
 
-        // Вспомогательные методы
+        // Снимки мира (RCU). snapshot_ читают без блокировок; публикация
+        // идёт под snapshot_mutex_. Снимок без читателей (spare) переиспользуется,
+        // чтобы не выделять память под столбцы каждый шаг.
+        // Порядок блокировок: npcs_mutex_, затем snapshot_mutex_.
+        mutable std::atomic<std::shared_ptr<const WorldSnapshot>> snapshot_;
+        mutable std::mutex snapshot_mutex_;
+        mutable std::shared_ptr<WorldSnapshot> published_;
+        mutable std::shared_ptr<WorldSnapshot> spare_;
+        mutable std::shared_ptr<const std::vector<std::string>> snapshot_names_;
+        mutable std::uint64_t snapshot_names_version_;
+        std::atomic<std::uint64_t> world_version_;
+
+        // Контрольные точки (под checkpoint_mutex_). Поток записи создаётся
+        // при первой точке; деструктор движка дожидается записи очереди.
+        mutable std::mutex checkpoint_mutex_;
+        CheckpointConfig checkpoint_config_;
+        std::shared_ptr<const WorldSnapshot> last_checkpoint_;
+        std::vector<std::string> checkpoint_chain_;
+        std::unique_ptr<checkpoint::Writer> checkpoint_writer_;
+
+        // Вывод карты (под cout_mutex_)
+        mutable std::unique_ptr<MapRenderer> renderer_;
+        MapRenderer::Mode render_mode_;
+
+        // Журнал боёв и номер источника движка в нём
+        std::shared_ptr<EventSink> events_;
+        std::uint32_t events_source_;
+        // Имена для журнала: публикуются вместе с записями об убийствах,
+        // поток журнала читает их без блокировок мира
+        std::atomic<std::shared_ptr<const std::vector<std::string>>> event_names_;
+        std::atomic<std::uint64_t> event_names_version_;
+
+        // Убитые, но ещё не убранные из сетки NPC
+        std::mutex dead_mutex_;
+        std::vector<WorldStore::Index> dead_pending_;
+
+        ThreadPool& pool() const;
+
+        int maxKillDistance() const;
+
+        // Фазы шага
         void processMovement();
-        void processMovement(Npc* npc);
-        void detectAndQueueCombats();
-        void processCombat(const MovementTask& task);
+        void processCombats();
+
+        // Шаг в режиме корутин
+        void stepCoroutines();
+        void spawnRoutines();
+        TickTask movementRoutine(WorldStore::Index from, WorldStore::Index to);
+        TickTask combatRoutine();
+
+        // Новая позиция NPC; сетку обновляет processMovement()
+        void processMovement(WorldStore::Index npc);
+
+        // Пара индексов, упорядоченная по имени (first < second)
+        struct CombatPair {
+            WorldStore::Index first;
+            WorldStore::Index second;
+        };
+
+        // Поиск пар; вызывающий держит npcs_mutex_
+        std::vector<CombatPair> collectCombatPairs() const;
+        std::vector<CombatPair> findCombatPairsBruteForce() const;
+        std::vector<CombatPair> findCombatPairsGrid() const;
+        void scanGridRows(int from, int to, std::vector<CombatPair>& pairs) const;
+        bool isCombatPair(WorldStore::Index npc1, WorldStore::Index npc2) const;
+        CombatPair makePair(WorldStore::Index npc1, WorldStore::Index npc2) const;
+        MovementTask makeTask(const CombatPair& pair) const;
+
+        // Пары шага без повторов (по ключу) и их постановка в очередь
+        std::vector<CombatPair> detectCombats();
+        void queueCombats(const std::vector<CombatPair>& pairs);
+
+        static std::uint64_t pairKey(WorldStore::Index npc1, WorldStore::Index npc2);
+        static void sortPairs(std::vector<CombatPair>& pairs);
+
+        // Запись об убийстве для вывода после снятия блокировок:
+        // номер задачи (пары) в пачке, кто из пары победил и индекс убитого
+        struct KillEvent {
+            size_t task;
+            bool by_first;
+            WorldStore::Index victim;
+        };
+
+        // Исход боя пары
+        struct FightOutcome {
+            bool first_killed = false;   // первый убил второго
+            bool second_killed = false;  // второй убил первого
+        };
+
+        // Бой пары; броски зависят только от зерна, шага и пары.
+        // Вызывающий отвечает за синхронизацию и порядок боёв.
+        FightOutcome fight(WorldStore::Index npc1, WorldStore::Index npc2);
+        static void appendKills(const std::vector<CombatPair>& pairs,
+                                const std::vector<FightOutcome>& outcomes,
+                                std::vector<KillEvent>& kills);
+
+        // Раскладывает пары на пачки, в каждой из которых NPC встречается не
+        // больше одного раза. Пара попадает в пачку после всех предыдущих
+        // пар со своими участниками, поэтому пачки по порядку дают тот же
+        // исход, что и бои по одному. Возвращает границы пачек в order.
+        std::vector<size_t> colourPairs(const std::vector<CombatPair>& pairs,
+                                        std::vector<size_t>& order);
+        // Убирает из сетки убитых фазой боёв; вызывающий держит npcs_mutex_
+        // эксклюзивно
+        void removeDeadFromGrid();
+
+        // Список имён текущей версии мира; вызывающий держит npcs_mutex_
+        // и snapshot_mutex_
+        const std::shared_ptr<const std::vector<std::string>>& currentNames() const;
+        // Публикует имена для журнала перед записью убийств;
+        // вызывающий держит npcs_mutex_
+        void shareEventNames();
+
+        // Публикация снимка; вызывающий держит npcs_mutex_,
+        // фаза боёв в это время не идёт
+        void publishSnapshot() const;
+
+        // Перенос позиций и статусов из world_ в объекты Npc
+        void syncNpcObjects();
+
+        // Источник журнала: имена по индексам берутся из последнего снимка
+        std::uint32_t addEventSource(EventSink& sink);
+
+        // Индексы живых NPC в порядке имён
+        std::vector<WorldStore::Index> aliveByName() const;
 };
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "world_snapshot.h"
+
+// Отрисовка карты мира в текстовый кадр.
+// Неизменная часть кадра (рамка, шапка, номера строк) строится один раз в
+// конструкторе; при каждом кадре перезаписываются только клетки и строка
+// счётчика в том же предвыделенном буфере, который выводится одним write.
+//
+// Режим Diff выводит только клетки, изменившиеся с прошлого кадра, через
+// ANSI-перемещения курсора. Первый кадр в этом режиме - полная перерисовка
+// с очисткой экрана.
+class MapRenderer {
+    public:
+        enum class Mode {
+            Full,
+            Diff
+        };
+
+        MapRenderer(int width, int height);
+
+        // Текст для вывода; ссылка действительна до следующего вызова
+        const std::string& render(const WorldSnapshot& snapshot, Mode mode = Mode::Full);
+
+        // Забыть прошлый кадр: следующий Diff будет полной перерисовкой
+        void reset();
+
+        int getWidth() const;
+        int getHeight() const;
+
+    private:
+        int width_;
+        int height_;
+
+        std::string frame_;               // полный кадр
+        std::string diff_;                // вывод режима Diff
+        size_t static_size_;              // длина кадра до строки счётчика
+        std::vector<size_t> row_offsets_; // начало клеток строки y в frame_
+        int first_row_line_;              // строка терминала (с 1) для y = 0
+        int cell_column_;                 // столбец терминала (с 1) для x = 0
+        int counter_line_;                // строка терминала со счётчиком живых
+        int total_lines_;                 // строк в кадре
+
+        std::vector<char> previous_;      // клетки прошлого кадра для Diff
+        std::string previous_counter_;
+        bool has_previous_;
+
+        void fill(const WorldSnapshot& snapshot);
+        void appendCounter(const WorldSnapshot& snapshot, std::string& out) const;
+        void renderDiff(const std::string& counter);
+        void appendCursor(int line, int column);
+};
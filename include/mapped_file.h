@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Файл, отображённый в память только для чтения (mmap).
+// Содержимое доступно как непрерывный буфер без копирования в кучу;
+// отображение снимается в деструкторе. Пустой файл - пустой буфер.
+class MappedFile {
+    public:
+        // Бросает std::runtime_error, если файл не удалось открыть
+        explicit MappedFile(const std::string& filename);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const char* data() const { return data_; }
+        size_t size() const { return size_; }
+        std::string_view view() const { return {data_, size_}; }
+
+    private:
+        const char* data_;
+        size_t size_;
+};
@@ -0,0 +1,225 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Статистика очереди для мониторинга обратного давления
+struct QueueStats {
+    std::uint64_t pushed;      // успешно добавлено
+    std::uint64_t popped;      // извлечено потребителями
+    std::uint64_t dropped;     // отклонено из-за переполнения
+    std::size_t depth;         // текущая глубина (приблизительно)
+    std::size_t high_water;    // максимальная наблюдавшаяся глубина
+    std::size_t capacity;
+};
+
+// Ограниченная lock-free очередь MPMC (кольцевой буфер Вьюкова).
+// Каждая ячейка хранит номер последовательности: производитель пишет в ячейку,
+// когда её номер равен позиции записи, потребитель читает, когда номер равен
+// позиции + 1. Блокирующее ожидание потребителей - через std::atomic::wait
+// (futex в Linux), без мьютексов на горячем пути.
+template <typename T>
+class MpmcQueue {
+    public:
+        explicit MpmcQueue(std::size_t capacity);
+
+        MpmcQueue(const MpmcQueue&) = delete;
+        MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+        // Добавление без ожидания; false если очередь заполнена или закрыта
+        bool tryPush(T value);
+
+        // Извлечение без ожидания; false если очередь пуста
+        bool tryPop(T& out);
+
+        // Извлекает до max элементов в out (дописывает в конец).
+        // Блокирует, пока не появится хотя бы один элемент или очередь не
+        // будет закрыта. Возвращает 0 только для закрытой и пустой очереди.
+        std::size_t popBatch(std::vector<T>& out, std::size_t max);
+
+        // То же без ожидания: 0, если очередь сейчас пуста
+        std::size_t tryPopBatch(std::vector<T>& out, std::size_t max);
+
+        // Закрытие будит всех ждущих потребителей
+        void close();
+        void reopen();
+        bool isClosed() const;
+
+        QueueStats getStats() const;
+        std::size_t capacity() const;
+
+    private:
+        struct Cell {
+            std::atomic<std::size_t> sequence;
+            T value;
+        };
+
+        std::size_t mask_;
+        std::unique_ptr<Cell[]> cells_;
+
+        // Позиции записи и чтения разнесены по разным кэш-линиям
+        alignas(64) std::atomic<std::size_t> enqueue_pos_;
+        alignas(64) std::atomic<std::size_t> dequeue_pos_;
+
+        alignas(64) std::atomic<std::uint32_t> signal_;
+        std::atomic<std::uint32_t> waiters_;
+        std::atomic<bool> closed_;
+
+        std::atomic<std::uint64_t> pushed_;
+        std::atomic<std::uint64_t> popped_;
+        std::atomic<std::uint64_t> dropped_;
+        std::atomic<std::size_t> high_water_;
+
+        std::size_t drain(std::vector<T>& out, std::size_t max);
+};
+
+template <typename T>
+MpmcQueue<T>::MpmcQueue(std::size_t capacity)
+    : enqueue_pos_(0), dequeue_pos_(0), signal_(0), waiters_(0), closed_(false),
+      pushed_(0), popped_(0), dropped_(0), high_water_(0) {
+    if (capacity < 2) {
+        throw std::invalid_argument("Queue capacity must be at least 2.");
+    }
+
+    // Ёмкость округляется вверх до степени двойки
+    std::size_t size = 2;
+    while (size < capacity) size <<= 1;
+
+    mask_ = size - 1;
+    cells_ = std::make_unique<Cell[]>(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+bool MpmcQueue<T>::tryPush(T value) {
+    if (closed_.load(std::memory_order_relaxed)) return false;
+
+    std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells_[pos & mask_];
+        std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->value = std::move(value);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+
+    std::uint64_t pushed = pushed_.fetch_add(1, std::memory_order_relaxed) + 1;
+    auto depth = static_cast<std::size_t>(pushed - popped_.load(std::memory_order_relaxed));
+    std::size_t high = high_water_.load(std::memory_order_relaxed);
+    while (depth > high && !high_water_.compare_exchange_weak(high, depth, std::memory_order_relaxed)) {
+    }
+
+    signal_.fetch_add(1);
+    if (waiters_.load() > 0) {
+        signal_.notify_one();
+    }
+    return true;
+}
+
+template <typename T>
+bool MpmcQueue<T>::tryPop(T& out) {
+    std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells_[pos & mask_];
+        std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+        if (diff == 0) {
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    out = std::move(cell->value);
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    popped_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+template <typename T>
+std::size_t MpmcQueue<T>::drain(std::vector<T>& out, std::size_t max) {
+    std::size_t count = 0;
+    T value;
+    while (count < max && tryPop(value)) {
+        out.push_back(std::move(value));
+        ++count;
+    }
+    return count;
+}
+
+template <typename T>
+std::size_t MpmcQueue<T>::popBatch(std::vector<T>& out, std::size_t max) {
+    for (;;) {
+        std::size_t count = drain(out, max);
+        if (count > 0) return count;
+
+        // Запоминаем сигнал до повторной проверки: push после этой точки
+        // изменит signal_, и wait вернётся сразу
+        std::uint32_t seen = signal_.load();
+        count = drain(out, max);
+        if (count > 0) return count;
+        if (closed_.load()) return 0;
+
+        waiters_.fetch_add(1);
+        signal_.wait(seen);
+        waiters_.fetch_sub(1);
+    }
+}
+
+template <typename T>
+std::size_t MpmcQueue<T>::tryPopBatch(std::vector<T>& out, std::size_t max) {
+    return drain(out, max);
+}
+
+template <typename T>
+void MpmcQueue<T>::close() {
+    closed_.store(true);
+    signal_.fetch_add(1);
+    signal_.notify_all();
+}
+
+template <typename T>
+void MpmcQueue<T>::reopen() {
+    closed_.store(false);
+}
+
+template <typename T>
+bool MpmcQueue<T>::isClosed() const {
+    return closed_.load();
+}
+
+template <typename T>
+QueueStats MpmcQueue<T>::getStats() const {
+    QueueStats stats{};
+    stats.pushed = pushed_.load(std::memory_order_relaxed);
+    stats.popped = popped_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    stats.depth = stats.pushed > stats.popped ? static_cast<std::size_t>(stats.pushed - stats.popped) : 0;
+    stats.high_water = high_water_.load(std::memory_order_relaxed);
+    stats.capacity = capacity();
+    return stats;
+}
+
+template <typename T>
+std::size_t MpmcQueue<T>::capacity() const {
+    return mask_ + 1;
+}
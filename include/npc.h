@@ -1,20 +1,31 @@
 #pragma once
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include "npc_name.h"
+#include "npc_type.h"
 
 class Visitor;  // Предварительное объявление класса Visitor
 
 class Npc {
     public:
-        Npc(int x, int y, const std::string& type, const std::string& name);
+        // Тип хранится только идентификатором, строка типа - из общей таблицы;
+        // имя - во встроенном буфере NpcName (не длиннее NpcName::kCapacity,
+        // иначе std::invalid_argument)
+        Npc(int x, int y, NpcTypeId typeId, std::string_view name);
 
         virtual ~Npc() = default;
 
         // Геттеры
         int getX() const;
         int getY() const;
-        std::string getType() const;
-        std::string getName() const;
+        const std::string& getType() const;
+        // Представление имени внутри объекта: действительно, пока жив NPC
+        std::string_view getName() const;
+        NpcTypeId getTypeId() const;
         bool isAlive() const;
 
         // Сеттеры
@@ -36,7 +47,32 @@ class Npc {
     private:
         int x_;
         int y_;
-        std::string type_;
-        std::string name_;
+        NpcName name_;
+        NpcTypeId type_id_;
         bool alive_;
-};
\ No newline at end of file
+};
+
+// Выравнивание памяти под NPC из std::pmr::memory_resource
+inline constexpr std::size_t kNpcAlignment = alignof(std::max_align_t);
+
+// Удаление NPC. Без ресурса - обычный delete; NPC, созданный фабрикой из
+// std::pmr::memory_resource, разрушается и возвращает память в тот же ресурс.
+// Преобразуется из std::default_delete, поэтому std::make_unique<Knight>(...)
+// подходит везде, где ждут NpcPtr.
+struct NpcDeleter {
+    std::pmr::memory_resource* resource = nullptr;
+    std::size_t size = 0;  // размер выделенного блока
+
+    NpcDeleter() = default;
+    NpcDeleter(std::pmr::memory_resource* resource, std::size_t size)
+        : resource(resource), size(size) {}
+
+    template <typename T>
+        requires std::is_convertible_v<T*, Npc*>
+    NpcDeleter(const std::default_delete<T>&) noexcept {}
+
+    void operator()(Npc* npc) const noexcept;
+};
+
+// Владение NPC: семантика std::unique_ptr<Npc>, память - из кучи или ресурса
+using NpcPtr = std::unique_ptr<Npc, NpcDeleter>;
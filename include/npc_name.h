@@ -0,0 +1,51 @@
+#pragma once
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// Имя NPC во встроенном буфере фиксированной ёмкости: без выделения
+// памяти и без указателя на кучу, объект Npc держит имя целиком в себе.
+// 24 байта против 32 у std::string (и кучи для имён длиннее 15 символов).
+class NpcName {
+    public:
+        static constexpr std::size_t kCapacity = 23;
+
+        NpcName() : data_{}, size_(0) {}
+
+        // Бросает std::invalid_argument для имени длиннее kCapacity
+        explicit NpcName(std::string_view name) : data_{}, size_(0) {
+            if (name.size() > kCapacity) {
+                throw std::invalid_argument("NPC name is longer than " + std::to_string(kCapacity) +
+                                            " characters: " + std::string(name));
+            }
+            std::memcpy(data_, name.data(), name.size());
+            size_ = static_cast<std::uint8_t>(name.size());
+        }
+
+        std::string_view view() const { return {data_, size_}; }
+        operator std::string_view() const { return view(); }
+
+        const char* data() const { return data_; }
+        std::size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+        friend bool operator==(const NpcName& a, const NpcName& b) { return a.view() == b.view(); }
+        friend std::strong_ordering operator<=>(const NpcName& a, const NpcName& b) {
+            return a.view() <=> b.view();
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const NpcName& name) {
+            return os << name.view();
+        }
+
+    private:
+        char data_[kCapacity];
+        std::uint8_t size_;
+};
+
+static_assert(sizeof(NpcName) == 24, "NpcName must stay a compact inline buffer");
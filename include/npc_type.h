@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Компактный идентификатор типа NPC.
+// Используется во внутренних циклах вместо сравнения строк.
+enum class NpcTypeId : std::uint8_t {
+    Knight = 0,
+    Druid = 1,
+    Elf = 2,
+    Unknown = 0xFF
+};
+
+// Количество известных типов (размер таблиц, индексируемых NpcTypeId)
+constexpr std::size_t kNpcTypeCount = 3;
+
+constexpr std::size_t toIndex(NpcTypeId id) {
+    return static_cast<std::size_t>(id);
+}
+
+// Название типа по идентификатору
+constexpr std::string_view npcTypeName(NpcTypeId id) {
+    switch (id) {
+        case NpcTypeId::Knight: return "Knight";
+        case NpcTypeId::Druid: return "Druid";
+        case NpcTypeId::Elf: return "Elf";
+        default: return "Unknown";
+    }
+}
+
+// Название типа строкой, живущей всю программу (для API со std::string)
+inline const std::string& npcTypeString(NpcTypeId id) {
+    static const std::string kNames[] = {
+        std::string(npcTypeName(NpcTypeId::Knight)),
+        std::string(npcTypeName(NpcTypeId::Druid)),
+        std::string(npcTypeName(NpcTypeId::Elf)),
+        std::string(npcTypeName(NpcTypeId::Unknown)),
+    };
+    std::size_t index = toIndex(id);
+    return kNames[index < kNpcTypeCount ? index : kNpcTypeCount];
+}
+
+// Идентификатор по названию, NpcTypeId::Unknown для неизвестных типов
+constexpr NpcTypeId npcTypeFromName(std::string_view name) {
+    for (std::size_t i = 0; i < kNpcTypeCount; ++i) {
+        NpcTypeId id = static_cast<NpcTypeId>(i);
+        if (npcTypeName(id) == name) return id;
+    }
+    return NpcTypeId::Unknown;
+}
@@ -1,10 +1,24 @@
 #pragma once
 #include <string>
+#include "battle_event.h"
 
 class Observer {
     public:
     virtual ~Observer() = default;
 
-    // Метод уведомления об изменениях в NPC
-    virtual void notify(const std::string& npcName) = 0;
-};
\ No newline at end of file
+    // Метод уведомления об изменениях в NPC (строковое событие)
+    virtual void notify(const std::string& npcName) {
+        (void)npcName;
+    }
+
+    // Типизированное событие боя. По умолчанию - переходник к строковому
+    // notify; наблюдатели, которым текст не нужен, переопределяют этот метод
+    virtual void onBattleEvent(const BattleEvent& event) {
+        notify(event.text());
+    }
+
+    // Бой закончен, Arena::startBattle сейчас вернёт управление. Наблюдатель
+    // с отложенным выводом в консоль дописывает здесь события боя, чтобы они
+    // не оказались после следующего прямого вывода вызывающего
+    virtual void onBattleEnd() {}
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+
+// Счётчиковый генератор случайных чисел на основе SplitMix64.
+// Последовательность задаётся ключом (seed, назначение, шаг, объект) и не
+// зависит от того, какой поток и в каком порядке её запрашивает. Поэтому
+// при одном seed симуляция повторяется при любом числе потоков.
+namespace rng {
+
+inline constexpr std::uint64_t kGamma = 0x9E3779B97F4A7C15ull;
+
+// Финализатор SplitMix64: хорошее перемешивание 64 бит
+constexpr std::uint64_t mix(std::uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Назначение потока случайных чисел
+enum class Stream : std::uint64_t {
+    Spawn = 1,     // создание случайных NPC
+    Movement = 2,  // направление и дальность шага NPC
+    Combat = 3     // броски кубика в бою пары
+};
+
+class CounterRng {
+    public:
+        constexpr CounterRng(std::uint64_t seed, Stream stream, std::uint64_t tick, std::uint64_t object)
+            : state_(mix(mix(mix(seed + static_cast<std::uint64_t>(stream) * kGamma) + tick) + object)) {}
+
+        constexpr std::uint64_t next() {
+            state_ += kGamma;
+            return mix(state_);
+        }
+
+        // Равномерно в [lo, hi] умножением со сдвигом; смещение порядка
+        // range / 2^32, для кубика и координат им можно пренебречь
+        constexpr int uniform(int lo, int hi) {
+            std::uint64_t range = static_cast<std::uint64_t>(static_cast<std::int64_t>(hi) - lo) + 1;
+            return lo + static_cast<int>(((next() >> 32) * range) >> 32);
+        }
+
+        // Равномерно в [0, 1) с 53 битами мантиссы
+        constexpr double unit() {
+            return static_cast<double>(next() >> 11) * 0x1.0p-53;
+        }
+
+    private:
+        std::uint64_t state_;
+};
+
+}
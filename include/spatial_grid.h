@@ -0,0 +1,123 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Равномерная сетка для поиска соседей.
+// Мир делится на квадратные ячейки со стороной не меньше максимальной
+// дальности атаки, поэтому любая пара NPC в зоне боя лежит в одной
+// ячейке или в двух соседних. Сетка хранит индексы NPC в WorldStore.
+class SpatialGrid {
+    public:
+        using Index = std::uint32_t;
+
+        SpatialGrid(int width, int height, int cellSize);
+
+        // Добавление / удаление NPC с позицией (x, y)
+        void insert(Index npc, int x, int y);
+        void remove(Index npc, int x, int y);
+
+        // Перенос NPC после перемещения из (oldX, oldY) в (newX, newY)
+        void update(Index npc, int oldX, int oldY, int newX, int newY);
+
+        void clear();
+
+        int getCellSize() const;
+        size_t size() const;
+
+        // Обход всех пар-кандидатов из соседних ячеек.
+        // Каждая пара посещается ровно один раз.
+        template <typename Fn>
+        void forEachCandidatePair(Fn&& fn) const;
+
+        // Пакетный обход для векторной проверки: для каждой непустой ячейки
+        // вызывает fn(block, cellCount), где block - NPC ячейки, за которыми
+        // идут NPC соседних ячеек. Партнёры block[i] (i < cellCount) -
+        // все элементы block[i + 1 ...]; так каждая пара встречается один раз.
+        template <typename Fn>
+        void forEachNeighbourhood(Fn&& fn) const;
+
+        // То же для строк ячеек [rowBegin, rowEnd): разные диапазоны строк
+        // можно обходить параллельно, пары между ними не теряются
+        template <typename Fn>
+        void forEachNeighbourhood(int rowBegin, int rowEnd, Fn&& fn) const;
+
+        int getRows() const;
+
+    private:
+        int cellSize_;
+        int cols_;
+        int rows_;
+        size_t size_;
+        std::vector<std::vector<Index>> cells_;
+
+        void erase(size_t cell, Index npc);
+
+        int cellCoord(int value, int count) const;
+        size_t cellIndex(int x, int y) const;
+};
+
+// Половина окрестности: правая, и три нижние ячейки.
+// Остальные соседи обойдут эту ячейку сами.
+inline constexpr int kGridForwardNeighbours[4][2] = {{1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+
+template <typename Fn>
+void SpatialGrid::forEachCandidatePair(Fn&& fn) const {
+    for (int cy = 0; cy < rows_; ++cy) {
+        for (int cx = 0; cx < cols_; ++cx) {
+            const auto& cell = cells_[static_cast<size_t>(cy) * cols_ + cx];
+            if (cell.empty()) continue;
+
+            // Пары внутри ячейки
+            for (size_t i = 0; i < cell.size(); ++i) {
+                for (size_t j = i + 1; j < cell.size(); ++j) {
+                    fn(cell[i], cell[j]);
+                }
+            }
+
+            // Пары с соседними ячейками
+            for (const auto& offset : kGridForwardNeighbours) {
+                int nx = cx + offset[0];
+                int ny = cy + offset[1];
+                if (nx < 0 || nx >= cols_ || ny >= rows_) continue;
+
+                const auto& other = cells_[static_cast<size_t>(ny) * cols_ + nx];
+                for (Index a : cell) {
+                    for (Index b : other) {
+                        fn(a, b);
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename Fn>
+void SpatialGrid::forEachNeighbourhood(Fn&& fn) const {
+    forEachNeighbourhood(0, rows_, std::forward<Fn>(fn));
+}
+
+template <typename Fn>
+void SpatialGrid::forEachNeighbourhood(int rowBegin, int rowEnd, Fn&& fn) const {
+    std::vector<Index> block;
+
+    for (int cy = rowBegin; cy < rowEnd; ++cy) {
+        for (int cx = 0; cx < cols_; ++cx) {
+            const auto& cell = cells_[static_cast<size_t>(cy) * cols_ + cx];
+            if (cell.empty()) continue;
+
+            block.assign(cell.begin(), cell.end());
+            for (const auto& offset : kGridForwardNeighbours) {
+                int nx = cx + offset[0];
+                int ny = cy + offset[1];
+                if (nx < 0 || nx >= cols_ || ny >= rows_) continue;
+
+                const auto& other = cells_[static_cast<size_t>(ny) * cols_ + nx];
+                block.insert(block.end(), other.begin(), other.end());
+            }
+
+            fn(block, cell.size());
+        }
+    }
+}
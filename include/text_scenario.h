@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Разбор текстового сценария: строки "тип имя x y".
+// Разбор идёт прямо по буферу файла (обычно MappedFile): поля - string_view
+// в буфер, числа читаются std::from_chars, память не выделяется.
+// Правила как у operator>>: поля разделяются пробельными символами,
+// текст после четвёртого поля игнорируется.
+namespace text_scenario {
+
+struct Record {
+    std::string_view type;
+    std::string_view name;
+    int x;
+    int y;
+};
+
+// false, если в строке нет четырёх полей или координаты не числа
+bool parseLine(std::string_view line, Record& record);
+
+// Бросает std::runtime_error "Failed to read line N: ..."
+[[noreturn]] void throwBadLine(size_t lineNumber, std::string_view line);
+
+// Вызов fn(record, номер строки) для каждой непустой строки буфера.
+// firstLine - номер первой строки буфера (для кусков файла)
+template <typename Fn>
+void forEachRecord(std::string_view data, Fn&& fn, size_t firstLine = 1) {
+    size_t lineNumber = firstLine - 1;
+    while (!data.empty()) {
+        ++lineNumber;
+        size_t end = data.find('\n');
+        std::string_view line = data.substr(0, end);
+        data.remove_prefix(end == std::string_view::npos ? data.size() : end + 1);
+
+        if (line.empty()) continue;
+
+        Record record;
+        if (!parseLine(line, record)) {
+            throwBadLine(lineNumber, line);
+        }
+        fn(record, lineNumber);
+    }
+}
+
+}
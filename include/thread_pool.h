@@ -0,0 +1,108 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Счётчики пула для мониторинга балансировки
+struct ThreadPoolStats {
+    std::uint64_t executed;  // выполнено задач
+    std::uint64_t stolen;    // из них украдено из чужих очередей
+};
+
+// Пул потоков с кражей работы.
+// У каждого рабочего своя дека: свои задачи он берёт с конца (LIFO, тёплый кэш),
+// простаивающие рабочие крадут с начала чужих дек. Задачи, поставленные извне
+// пула, раскладываются по декам по кругу. Поток, ждущий завершения пачки
+// (run / parallelFor), сам выполняет задачи, а когда брать нечего - спит
+// до завершения очередной задачи пачки.
+class ThreadPool {
+    public:
+        using Task = std::function<void()>;
+
+        // workers == 0 заменяется на 1
+        explicit ThreadPool(size_t workers);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        size_t size() const;
+
+        // Постановка задачи без ожидания. Исключение задачи не покидает
+        // рабочий поток, а передаётся через future.
+        std::future<void> submit(Task task);
+
+        // Выполняет все задачи и ждёт их завершения. Первое исключение
+        // из задач пробрасывается вызывающему после завершения остальных.
+        void run(std::vector<Task> tasks);
+
+        // Делит [begin, end) на куски не меньше grain и вызывает fn(from, to)
+        // для каждого куска параллельно. Возвращает после обработки всех.
+        template <typename Fn>
+        void parallelFor(size_t begin, size_t end, size_t grain, Fn&& fn);
+
+        ThreadPoolStats getStats() const;
+
+    private:
+        struct Worker {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Worker>> queues_;
+        std::vector<std::thread> threads_;
+
+        // Ожидание работы: pending_ меняется под sleep_mutex_,
+        // поэтому пробуждение не теряется
+        std::mutex sleep_mutex_;
+        std::condition_variable wake_;
+        std::atomic<size_t> pending_;
+        bool stopping_;
+
+        std::atomic<size_t> next_queue_;
+        std::atomic<std::uint64_t> executed_;
+        std::atomic<std::uint64_t> stolen_;
+
+        void workerLoop(size_t index);
+
+        // Кладёт задачу в деку; задача не должна бросать исключений
+        void enqueue(Task task);
+
+        // Берёт задачу из своей деки или крадёт чужую; false если пусто.
+        // self == size() для потоков вне пула.
+        bool tryRunOne(size_t self);
+        size_t currentWorker() const;
+};
+
+template <typename Fn>
+void ThreadPool::parallelFor(size_t begin, size_t end, size_t grain, Fn&& fn) {
+    if (begin >= end) return;
+    if (grain == 0) grain = 1;
+
+    // Кусков в несколько раз больше, чем рабочих, чтобы было что красть
+    size_t total = end - begin;
+    size_t chunks = std::max<size_t>(1, std::min(total / grain, size() * 4));
+    size_t step = (total + chunks - 1) / chunks;
+
+    if (chunks == 1) {
+        fn(begin, end);
+        return;
+    }
+
+    std::vector<Task> tasks;
+    tasks.reserve(chunks);
+    for (size_t from = begin; from < end; from += step) {
+        size_t to = std::min(end, from + step);
+        tasks.push_back([&fn, from, to] { fn(from, to); });
+    }
+    run(std::move(tasks));
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+// Корутина, живущая много шагов симуляции. Создаётся приостановленной,
+// запускается планировщиком и между шагами ждёт co_await scheduler.nextTick().
+class TickTask {
+    public:
+        struct promise_type {
+            std::exception_ptr error;
+
+            TickTask get_return_object() {
+                return TickTask(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { error = std::current_exception(); }
+        };
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        TickTask(TickTask&& other) noexcept;
+        TickTask& operator=(TickTask&& other) noexcept;
+        TickTask(const TickTask&) = delete;
+        TickTask& operator=(const TickTask&) = delete;
+        ~TickTask();
+
+    private:
+        explicit TickTask(Handle handle) : handle_(handle) {}
+
+        Handle handle_;
+
+        friend class TickScheduler;
+};
+
+// Кооперативный однопоточный планировщик шагов.
+// Корутины, ждущие следующий шаг, возобновляются в runTick() по очереди
+// в том порядке, в котором они приостановились. Никаких потоков и блокировок:
+// переключение между корутинами - обычный вызов resume().
+class TickScheduler {
+    public:
+        // Ожидание следующего шага
+        struct NextTick {
+            TickScheduler& scheduler;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(TickTask::Handle handle) { scheduler.next_.push_back(handle); }
+            void await_resume() const noexcept {}
+        };
+
+        TickScheduler() = default;
+        TickScheduler(const TickScheduler&) = delete;
+        TickScheduler& operator=(const TickScheduler&) = delete;
+        ~TickScheduler();
+
+        // Передача корутины планировщику; первый раз она выполнится
+        // в ближайшем runTick()
+        void spawn(TickTask task);
+
+        NextTick nextTick() { return NextTick{*this}; }
+
+        // Один шаг: возобновляет все ждущие корутины. Исключение из
+        // корутины пробрасывается вызывающему.
+        void runTick();
+
+        // Уничтожает все корутины
+        void clear();
+
+        size_t size() const;
+        std::uint64_t getTick() const;
+        std::uint64_t getResumes() const;
+
+    private:
+        std::vector<TickTask> tasks_;
+        std::vector<TickTask::Handle> ready_;
+        std::vector<TickTask::Handle> next_;
+        std::uint64_t tick_ = 0;
+        std::uint64_t resumes_ = 0;
+};
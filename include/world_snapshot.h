@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "npc_type.h"
+
+// Неизменяемый снимок мира после шага симуляции.
+// Движок публикует новый снимок атомарной заменой shared_ptr (RCU):
+// читатели держат свой снимок сколько угодно и не блокируют симуляцию,
+// старый снимок освобождается, когда его отпустит последний читатель.
+struct WorldSnapshot {
+    std::uint64_t tick = 0;     // номер шага, после которого снят снимок
+    std::uint64_t version = 0;  // версия состава NPC (меняется в addNpc)
+    int width = 0;
+    int height = 0;
+
+    // Столбцы как в WorldStore, индексы совпадают
+    std::vector<int> xs;
+    std::vector<int> ys;
+    std::vector<NpcTypeId> types;
+    std::vector<std::uint8_t> alive;
+
+    // Имена меняются только при добавлении NPC, поэтому общие для снимков
+    std::shared_ptr<const std::vector<std::string>> names;
+
+    size_t size() const { return xs.size(); }
+    bool isAlive(size_t i) const { return alive[i] != 0; }
+    const std::string& getName(size_t i) const { return (*names)[i]; }
+
+    size_t aliveCount() const;
+
+    // Имена живых NPC по возрастанию
+    std::vector<std::string> survivors() const;
+};
@@ -0,0 +1,99 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "npc_type.h"
+
+class ThreadPool;
+
+// Хранилище мира в виде структуры массивов (SoA).
+// Координаты, типы и флаги жизни лежат в отдельных непрерывных массивах,
+// поэтому проходы движения, поиска боёв и отрисовки читают память линейно.
+// Имена хранятся отдельно и нужны только для внешнего API: символы всех
+// имён подряд в одном буфере, у NPC - только 32-битное смещение своего
+// имени в нём (4 байта на NPC вместо std::string и выделения под строку).
+//
+// Флаг жизни читается и сбрасывается атомарно (std::atomic_ref), поэтому
+// бои могут убивать NPC параллельно, держа лишь разделяемую блокировку мира.
+class WorldStore {
+    public:
+        using Index = std::uint32_t;
+        using TypeId = NpcTypeId;
+
+        static constexpr Index kNotFound = static_cast<Index>(-1);
+
+        // Добавление NPC; если имя уже занято, слот перезаписывается
+        Index add(std::string_view name, TypeId type, int x, int y, bool alive);
+
+        // Добавление пачки NPC в конец. Имена должны быть различны и ещё не
+        // заняты (это не проверяется). Символы имён и таблица поиска
+        // заполняются параллельно пулом. Возвращает индекс первого.
+        Index append(const std::vector<std::string>& names, const std::vector<TypeId>& types,
+                     const std::vector<int>& xs, const std::vector<int>& ys,
+                     ThreadPool& pool, size_t grain);
+
+        // Поиск по имени, kNotFound если такого NPC нет
+        Index find(std::string_view name) const;
+
+        size_t size() const;
+        void clear();
+
+        // Память под count NPC, включая таблицу имён (но не их символы)
+        void reserve(size_t count);
+
+        // Доступ к полям по индексу
+        int getX(Index i) const { return x_[i]; }
+        int getY(Index i) const { return y_[i]; }
+        TypeId getTypeId(Index i) const { return type_id_[i]; }
+        bool isAlive(Index i) const {
+            return std::atomic_ref<std::uint8_t>(const_cast<std::uint8_t&>(alive_[i]))
+                .load(std::memory_order_acquire) != 0;
+        }
+        // Представление действительно до следующего add / append / clear
+        std::string_view getName(Index i) const {
+            return {name_chars_.data() + name_offsets_[i], name_offsets_[i + 1] - name_offsets_[i]};
+        }
+        std::string_view getType(Index i) const { return npcTypeName(type_id_[i]); }
+
+        void setPosition(Index i, int x, int y) { x_[i] = x; y_[i] = y; }
+        // true, если NPC был жив и убит именно этим вызовом
+        bool kill(Index i) {
+            std::uint8_t expected = 1;
+            return std::atomic_ref<std::uint8_t>(alive_[i])
+                .compare_exchange_strong(expected, 0, std::memory_order_acq_rel);
+        }
+
+        // Непрерывные массивы для пакетной обработки.
+        // Столбец alive читать напрямую можно только без параллельных боёв.
+        const std::vector<int>& getXs() const { return x_; }
+        const std::vector<int>& getYs() const { return y_; }
+        const std::vector<TypeId>& getTypeIds() const { return type_id_; }
+        const std::vector<std::uint8_t>& getAlive() const { return alive_; }
+
+        // Копия имён строками (для снимков мира)
+        std::vector<std::string> copyNames() const;
+
+    private:
+        std::vector<int> x_;
+        std::vector<int> y_;
+        std::vector<TypeId> type_id_;
+        std::vector<std::uint8_t> alive_;
+        // Имя i - name_chars_[name_offsets_[i], name_offsets_[i + 1]);
+        // name_offsets_ всегда на один элемент длиннее числа NPC
+        std::vector<char> name_chars_;
+        std::vector<std::uint32_t> name_offsets_ = {0};
+
+        // Таблица имён с открытой адресацией и линейным пробированием.
+        // Слот - старшие 32 бита хеша имени и индекс + 1 (0 - пустой слот):
+        // строки сравниваются только при совпадении хеша, вставка не
+        // выделяет память. Заполнена не больше чем наполовину.
+        std::vector<std::uint64_t> slots_;
+
+        static std::uint64_t hashName(std::string_view name);
+        // Слот с этим именем или первый пустой на его пути
+        size_t probe(std::string_view name, std::uint64_t hash) const;
+        // Вместимость таблицы не меньше чем на count имён
+        void rehash(size_t count);
+};
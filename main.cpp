@@ -1,9 +1,15 @@
 #include "include/game_engine.h"
+#include "include/combat_rules.h"
 #include <iostream>
 #include <memory>
 
-int main() {
+int main(int argc, char* argv[]) {
     try {
+        // Необязательный файл правил боя: ./lab7_main rules.txt
+        if (argc > 1) {
+            CombatRules::setActive(CombatRules::loadFromFile(argv[1]));
+        }
+
         GameEngine engine(100, 100);
         engine.createRandomNpcs(50);
         engine.runSimulation(30);
@@ -1,14 +1,28 @@
 #include "../include/arena.h"
 #include "../include/factory.h"
 #include "../include/combat_visitor.h"
+#include "../include/binary_scenario.h"
+#include "../include/mapped_file.h"
+#include "../include/text_scenario.h"
+#include "../include/thread_pool.h"
 #include <iostream>
 #include <memory>
 #include <fstream>
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <cstdlib>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <thread>
 
-Arena::Arena(int width, int height) {
+Arena::Arena(int width, int height, std::pmr::memory_resource* memory)
+    : memory_(memory),
+      npcs_(memory ? memory : std::pmr::get_default_resource()),
+      battle_mode_(BattleMode::SweepAndPrune),
+      load_mode_(LoadMode::Serial),
+      load_workers_(1) {
     if (width > MAX_WIDTH || height > MAX_HEIGHT) {
         throw std::out_of_range("Arena size exceeds maximum limits.");
     }
@@ -16,24 +30,23 @@ Arena::Arena(int width, int height) {
     this->height_ = height;
 }
 
-void Arena::addNpc(std::unique_ptr<Npc> npc) {
-    const std::string name  = npc->getName();
+void Arena::addNpc(NpcPtr npc) {
+    std::string_view name = npc->getName();
 
-    if (npc->getX() < 0 || npc->getX() > width_ ||
-        npc->getY() < 0 || npc->getY() > height_) {
+    if (!inBounds(npc->getX(), npc->getY())) {
         throw std::out_of_range("NPC position is out of arena bounds.");
     }
 
     if (npcs_.find(name) != npcs_.end()) {
         throw std::invalid_argument("NPC with this name already exists.");
     }
-    npcs_[name] = std::move(npc);
+    npcs_.emplace(name, std::move(npc));
 }
 
 void Arena::createAndAddNpc(const std::string& type, 
                             const std::string& name, 
                             int x, int y) {
-    auto npc = NpcFactory::createNpc(type, name, x, y);
+    auto npc = NpcFactory::createNpc(type, name, x, y, memory_);
     addNpc(std::move(npc));
 }
 
@@ -48,35 +61,360 @@ size_t Arena::getNpcCount() const {
 }
 
 
-void Arena::saveToFile(const std::string& filename) const {
+bool Arena::inBounds(int x, int y) const {
+    return x >= 0 && x <= width_ && y >= 0 && y <= height_;
+}
+
+
+void Arena::saveToFile(const std::string& filename, FileFormat format) const {
+    if (format == FileFormat::Binary) {
+        saveBinary(filename);
+    } else {
+        saveText(filename);
+    }
+}
+
+void Arena::saveText(const std::string& filename) const {
     std::ofstream file(filename);
     if (!file.is_open()) {
         throw std::runtime_error("Failed to open file for writing: " + filename);
     }
 
+    // '\n' вместо std::endl: без сброса буфера на каждой строке
     for (const auto& [name, npc] : npcs_) {
         file << npc->getType() << " "
              << npc->getName() << " "
              << npc->getX() << " "
-             << npc->getY() << std::endl;
+             << npc->getY() << '\n';
+    }
+}
+
+void Arena::saveBinary(const std::string& filename) const {
+    binary_scenario::Columns columns;
+    columns.types.reserve(npcs_.size());
+    columns.coords.reserve(npcs_.size());
+    columns.names.reserve(npcs_.size());
+
+    for (const auto& [name, npc] : npcs_) {
+        columns.types.push_back(npc->getTypeId());
+        columns.coords.push_back({npc->getX(), npc->getY()});
+        columns.names.push_back(name);
     }
+
+    binary_scenario::write(filename, columns);
 }
 
 
 void Arena::loadFromFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open file for reading: " + filename);
+    MappedFile file(filename);
+
+    if (load_mode_ == LoadMode::Parallel) {
+        loadParallel(file.view());
+    } else if (binary_scenario::hasMagic(file.view())) {
+        loadBinary(file.view());
+    } else {
+        loadText(file.view());
+    }
+}
+
+void Arena::loadText(std::string_view data) {
+    text_scenario::forEachRecord(data, [this](const text_scenario::Record& record, size_t lineNumber) {
+        NpcTypeId type = npcTypeFromName(record.type);
+        if (type == NpcTypeId::Unknown) {
+            throw std::invalid_argument("Unknown NPC type (line " + std::to_string(lineNumber) +
+                                        "): " + std::string(record.type));
+        }
+        if (!inBounds(record.x, record.y)) {
+            throw std::out_of_range("NPC position is out of arena bounds.");
+        }
+
+        auto npc = NpcFactory::createNpc(type, std::string(record.name), record.x, record.y, memory_);
+        emplaceSorted(std::move(npc));
+    });
+}
+
+void Arena::loadBinary(std::string_view data) {
+    binary_scenario::View view(data);
+
+    for (size_t i = 0; i < view.size(); ++i) {
+        binary_scenario::Coord coord = view.coord(i);
+
+        // Тип проверяется раньше координат, как в текстовом формате
+        auto npc = NpcFactory::createNpc(view.type(i), std::string(view.name(i)), coord.x, coord.y, memory_);
+        if (!inBounds(coord.x, coord.y)) {
+            throw std::out_of_range("NPC position is out of arena bounds.");
+        }
+        emplaceSorted(std::move(npc));
+    }
+}
+
+namespace {
+
+// Проверенная запись сценария; имя указывает в буфер файла.
+// position - номер записи в файле, задаётся после разбора всех кусков
+struct LoadRecord {
+    std::string_view name;
+    NpcTypeId type;
+    int x;
+    int y;
+    size_t position;
+};
+
+// Результат разбора куска: записи до первой ошибки и сама ошибка
+struct LoadChunk {
+    std::string_view text;
+    size_t lines = 0;       // переводов строк в куске
+    size_t first_line = 1;
+    size_t begin = 0;  // для двоичного файла - диапазон индексов
+    size_t end = 0;
+    std::vector<LoadRecord> records;
+    std::exception_ptr error;
+};
+
+// Куски не меньше minBytes, каждый заканчивается переводом строки
+std::vector<std::string_view> splitAtNewlines(std::string_view data, size_t pieces, size_t minBytes) {
+    std::vector<std::string_view> result;
+    size_t step = std::max(minBytes, (data.size() + pieces - 1) / std::max<size_t>(1, pieces));
+    while (!data.empty()) {
+        size_t end = data.size() <= step ? std::string_view::npos : data.find('\n', step);
+        end = end == std::string_view::npos ? data.size() : end + 1;
+        result.push_back(data.substr(0, end));
+        data.remove_prefix(end);
+    }
+    return result;
+}
+
+}
+
+void Arena::setLoadMode(LoadMode mode, size_t workers) {
+    load_mode_ = mode;
+    load_workers_ = workers == 0 ? std::max(1u, std::thread::hardware_concurrency()) : workers;
+}
+
+Arena::LoadMode Arena::getLoadMode() const {
+    return load_mode_;
+}
+
+size_t Arena::getLoadWorkerCount() const {
+    return load_workers_;
+}
+
+void Arena::loadParallel(std::string_view data) {
+    ThreadPool pool(load_workers_);
+    const size_t pieces = pool.size() * 4;
+    std::vector<LoadChunk> chunks;
+
+    // Разбор и проверка кусков. Кусок останавливается на первой ошибке;
+    // ошибки проверки те же, что у последовательной загрузки
+    auto validate = [this](LoadChunk& chunk, const LoadRecord& record, auto&& describeType) {
+        if (toIndex(record.type) >= kNpcTypeCount) {
+            throw std::invalid_argument(describeType());
+        }
+        if (!inBounds(record.x, record.y)) {
+            throw std::out_of_range("NPC position is out of arena bounds.");
+        }
+        chunk.records.push_back(record);
+    };
+
+    if (binary_scenario::hasMagic(data)) {
+        binary_scenario::View view(data);
+        size_t step = std::max<size_t>(kLoadChunkBytes / 16, (view.size() + pieces - 1) / pieces);
+        for (size_t from = 0; from < view.size(); from += step) {
+            LoadChunk chunk;
+            chunk.begin = from;
+            chunk.end = std::min(view.size(), from + step);
+            chunks.push_back(std::move(chunk));
+        }
+
+        pool.parallelFor(0, chunks.size(), 1, [&](size_t from, size_t to) {
+            for (size_t c = from; c < to; ++c) {
+                LoadChunk& chunk = chunks[c];
+                chunk.records.reserve(chunk.end - chunk.begin);
+                try {
+                    for (size_t i = chunk.begin; i < chunk.end; ++i) {
+                        binary_scenario::Coord coord = view.coord(i);
+                        LoadRecord record{view.name(i), view.type(i), coord.x, coord.y, 0};
+                        validate(chunk, record, [&] {
+                            return "Unknown NPC type id: " + std::to_string(static_cast<int>(record.type));
+                        });
+                    }
+                } catch (...) {
+                    chunk.error = std::current_exception();
+                }
+            }
+        });
+    } else {
+        for (std::string_view text : splitAtNewlines(data, pieces, kLoadChunkBytes)) {
+            LoadChunk chunk;
+            chunk.text = text;
+            chunks.push_back(std::move(chunk));
+        }
+
+        // Номер первой строки каждого куска: подсчёт переводов строк параллельно
+        pool.parallelFor(0, chunks.size(), 1, [&](size_t from, size_t to) {
+            for (size_t c = from; c < to; ++c) {
+                chunks[c].lines = static_cast<size_t>(
+                    std::count(chunks[c].text.begin(), chunks[c].text.end(), '\n'));
+            }
+        });
+        size_t line = 1;
+        for (LoadChunk& chunk : chunks) {
+            chunk.first_line = line;
+            line += chunk.lines;
+        }
+
+        pool.parallelFor(0, chunks.size(), 1, [&](size_t from, size_t to) {
+            for (size_t c = from; c < to; ++c) {
+                LoadChunk& chunk = chunks[c];
+                chunk.records.reserve(chunk.lines + 1);  // записей не больше, чем строк
+                try {
+                    text_scenario::forEachRecord(chunk.text, [&](const text_scenario::Record& parsed, size_t lineNumber) {
+                        LoadRecord record{parsed.name, npcTypeFromName(parsed.type), parsed.x, parsed.y, 0};
+                        validate(chunk, record, [&] {
+                            return "Unknown NPC type (line " + std::to_string(lineNumber) +
+                                   "): " + std::string(parsed.type);
+                        });
+                    }, chunk.first_line);
+                } catch (...) {
+                    chunk.error = std::current_exception();
+                }
+            }
+        });
+    }
+
+    // Записи в порядке файла до первой ошибки. Позиция ошибки - номер
+    // записи, которая была бы следующей в её куске
+    std::exception_ptr error;
+    size_t error_position = SIZE_MAX;
+    std::vector<size_t> offsets;
+    size_t total = 0;
+    for (const LoadChunk& chunk : chunks) {
+        offsets.push_back(total);
+        total += chunk.records.size();
+        if (chunk.error) {
+            error = chunk.error;
+            error_position = total;
+            break;
+        }
+    }
+
+    // Порядок по (имя, позиция в файле): сортировка кусков пулом, затем
+    // попарные слияния. Результат не зависит от числа потоков
+    std::vector<LoadRecord*> order(total);
+    pool.parallelFor(0, offsets.size(), 1, [&](size_t from, size_t to) {
+        for (size_t c = from; c < to; ++c) {
+            for (size_t j = 0; j < chunks[c].records.size(); ++j) {
+                LoadRecord& record = chunks[c].records[j];
+                record.position = offsets[c] + j;
+                order[record.position] = &record;
+            }
+        }
+    });
+    auto byName = [](const LoadRecord* a, const LoadRecord* b) {
+        int cmp = a->name.compare(b->name);
+        return cmp != 0 ? cmp < 0 : a->position < b->position;
+    };
+
+    size_t run = std::max<size_t>(1, (order.size() + pieces - 1) / pieces);
+    std::vector<size_t> bounds;
+    for (size_t from = 0; from < order.size(); from += run) bounds.push_back(from);
+    bounds.push_back(order.size());
+
+    // Сохранённые файлы уже упорядочены по имени - тогда сортировка не нужна
+    std::atomic<bool> sorted{true};
+    pool.parallelFor(0, bounds.size() - 1, 1, [&](size_t from, size_t to) {
+        for (size_t r = from; r < to && sorted.load(std::memory_order_relaxed); ++r) {
+            size_t last = std::min(bounds[r + 1] + 1, order.size());
+            if (!std::is_sorted(order.begin() + static_cast<std::ptrdiff_t>(bounds[r]),
+                                order.begin() + static_cast<std::ptrdiff_t>(last), byName)) {
+                sorted.store(false, std::memory_order_relaxed);
+            }
+        }
+    });
+    if (sorted.load()) bounds.resize(1);
+
+    pool.parallelFor(0, bounds.size() - 1, 1, [&](size_t from, size_t to) {
+        for (size_t r = from; r < to; ++r) {
+            std::sort(order.begin() + static_cast<std::ptrdiff_t>(bounds[r]),
+                      order.begin() + static_cast<std::ptrdiff_t>(bounds[r + 1]), byName);
+        }
+    });
+    while (bounds.size() > 2) {
+        std::vector<size_t> merged;
+        for (size_t r = 0; r + 1 < bounds.size(); r += 2) merged.push_back(bounds[r]);
+        merged.push_back(order.size());
+
+        pool.parallelFor(0, bounds.size() / 2, 1, [&](size_t from, size_t to) {
+            for (size_t r = from; r < to; ++r) {
+                size_t left = bounds[2 * r];
+                size_t middle = bounds[2 * r + 1];
+                size_t right = 2 * r + 2 < bounds.size() ? bounds[2 * r + 2] : order.size();
+                std::inplace_merge(order.begin() + static_cast<std::ptrdiff_t>(left),
+                                   order.begin() + static_cast<std::ptrdiff_t>(middle),
+                                   order.begin() + static_cast<std::ptrdiff_t>(right), byName);
+            }
+        });
+        bounds = std::move(merged);
+    }
+
+    // Первая по порядку файла запись, на которой последовательная загрузка
+    // нашла бы дубликат: повтор имени в файле или имя, уже бывшее на арене
+    size_t duplicate_position = SIZE_MAX;
+    auto existing = npcs_.begin();
+    for (size_t k = 0; k < order.size(); ++k) {
+        const LoadRecord& record = *order[k];
+        if (k > 0 && order[k - 1]->name == record.name) {
+            duplicate_position = std::min(duplicate_position, record.position);
+            continue;
+        }
+
+        while (existing != npcs_.end() && std::string_view(existing->first) < record.name) ++existing;
+        if (existing != npcs_.end() && std::string_view(existing->first) == record.name) {
+            duplicate_position = std::min(duplicate_position, record.position);
+        }
+    }
+
+    if (duplicate_position < error_position) {
+        throw std::invalid_argument("NPC with this name already exists.");
+    }
+    if (error) {
+        std::rethrow_exception(error);
     }
 
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.empty()) continue;
+    // Создание NPC пулом, вставка одной пачкой в порядке имён.
+    // Ресурс памяти арены не обязан быть потокобезопасным: с ним NPC
+    // создаются в одном потоке
+    std::vector<NpcPtr> created(order.size());
+    auto create = [&](size_t from, size_t to) {
+        for (size_t k = from; k < to; ++k) {
+            const LoadRecord& record = *order[k];
+            created[k] = NpcFactory::createNpc(record.type, std::string(record.name), record.x, record.y,
+                                               memory_);
+        }
+    };
+    if (memory_) {
+        create(0, order.size());
+    } else {
+        pool.parallelFor(0, order.size(), 4096, create);
+    }
 
-        auto npc = NpcFactory::createFromString(line);
+    if (order.empty()) return;
+    auto hint = npcs_.lower_bound(order[0]->name);
+    for (size_t k = 0; k < order.size(); ++k) {
+        std::string_view name = created[k]->getName();
+        hint = std::next(npcs_.emplace_hint(hint, name, std::move(created[k])));
+    }
+}
 
-        addNpc(std::move(npc));
+void Arena::emplaceSorted(NpcPtr npc) {
+    // Сохранённые файлы упорядочены по имени как npcs_, поэтому вставка
+    // с подсказкой end() обходится без поиска по дереву
+    size_t before = npcs_.size();
+    auto it = npcs_.emplace_hint(npcs_.end(), std::string_view(npc->getName()), nullptr);
+    if (npcs_.size() == before) {
+        throw std::invalid_argument("NPC with this name already exists.");
     }
+    it->second = std::move(npc);
 }
 
 
@@ -84,6 +422,10 @@ void Arena::clear() {
     npcs_.clear();
 }
 
+std::pmr::memory_resource* Arena::getMemoryResource() const {
+    return memory_;
+}
+
 
 
 void Arena::addObserver(std::shared_ptr<Observer> observer) {
@@ -95,53 +437,132 @@ void Arena::removeObserver(std::shared_ptr<Observer> observer) {
 }
 
 
-void Arena::notifyObservers(const std::string& event) {
+void Arena::notifyObservers(const BattleEvent& event) {
+    // Текст события собирается, только если его попросит наблюдатель
     for (auto& observer : observers_) {
-        observer->notify(event);
+        observer->onBattleEvent(event);
     }
 }
 
 
-void Arena::startBattle(double range) {
-    CombatVisitor visitor;
-    std::vector<std::string> toRemove; // Имена NPC для удаления
+void Arena::setBattleMode(BattleMode mode) {
+    battle_mode_ = mode;
+}
+
+Arena::BattleMode Arena::getBattleMode() const {
+    return battle_mode_;
+}
+
+
+std::vector<std::pair<Npc*, Npc*>> Arena::findPairsBruteForce(double range) const {
+    std::vector<std::pair<Npc*, Npc*>> pairs;
 
     // Проверяем каждую пару NPC
-    for (auto& [name1, npc1] : npcs_) {
-        for (auto& [name2, npc2] : npcs_) {
+    for (const auto& [name1, npc1] : npcs_) {
+        for (const auto& [name2, npc2] : npcs_) {
             if (name1 == name2) continue; // Пропускаем самого себя
             if (name1 > name2) continue;  // Избегаем дублирования пар (A,B) и (B,A)
 
             // Проверяем расстояние
             if (npc1->distanceTo(*npc2) > range) continue;
-            
-            // Проверяем бой в обе стороны
-            bool npc1KillsNpc2 = visitor.canKill(npc1.get(), npc2.get());
-            bool npc2KillsNpc1 = visitor.canKill(npc2.get(), npc1.get());
-            
-            if (npc1KillsNpc2 && npc2KillsNpc1) {
-                // Оба убивают друг друга
-                std::string event = npc1->getName() + " (" + npc1->getType() + 
-                                   ") and " + npc2->getName() + " (" + npc2->getType() + 
-                                   ") killed each other";
-                notifyObservers(event);
-                toRemove.push_back(name1);
-                toRemove.push_back(name2);
-            } else if (npc1KillsNpc2) {
-                // Только npc1 убивает npc2
-                std::string event = npc1->getName() + " (" + npc1->getType() + 
-                                   ") killed " + npc2->getName() + " (" + npc2->getType() + ")";
-                notifyObservers(event);
-                toRemove.push_back(name2);
-            } else if (npc2KillsNpc1) {
-                // Только npc2 убивает npc1
-                std::string event = npc2->getName() + " (" + npc2->getType() + 
-                                   ") killed " + npc1->getName() + " (" + npc1->getType() + ")";
-                notifyObservers(event);
-                toRemove.push_back(name1);
+
+            pairs.push_back({npc1.get(), npc2.get()});
+        }
+    }
+
+    return pairs;
+}
+
+
+std::vector<std::pair<Npc*, Npc*>> Arena::findPairsSweepAndPrune(double range) const {
+    struct Entry {
+        int x;
+        int y;
+        const std::string_view* name;
+        Npc* npc;
+    };
+
+    std::vector<Entry> entries;
+    entries.reserve(npcs_.size());
+    for (const auto& [name, npc] : npcs_) {
+        entries.push_back({npc->getX(), npc->getY(), &name, npc.get()});
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.x < b.x;
+    });
+
+    // Пары, чьи интервалы [x - range, x + range] пересекаются
+    std::vector<std::pair<const Entry*, const Entry*>> candidates;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const Entry& a = entries[i];
+        for (size_t j = i + 1; j < entries.size(); ++j) {
+            const Entry& b = entries[j];
+            if (b.x - a.x > range) break;
+            if (std::abs(b.y - a.y) > range) continue;
+            if (a.npc->distanceTo(*b.npc) > range) continue;
+
+            if (*a.name < *b.name) {
+                candidates.push_back({&a, &b});
+            } else {
+                candidates.push_back({&b, &a});
             }
         }
     }
+
+    // Тот же порядок пар, что и при переборе по std::map
+    std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+        if (*lhs.first->name != *rhs.first->name) {
+            return *lhs.first->name < *rhs.first->name;
+        }
+        return *lhs.second->name < *rhs.second->name;
+    });
+
+    std::vector<std::pair<Npc*, Npc*>> pairs;
+    pairs.reserve(candidates.size());
+    for (const auto& [a, b] : candidates) {
+        pairs.push_back({a->npc, b->npc});
+    }
+    return pairs;
+}
+
+
+void Arena::resolvePair(Npc* npc1, Npc* npc2, CombatVisitor& visitor,
+                        std::vector<std::string_view>& toRemove) {
+    // Проверяем бой в обе стороны
+    bool npc1KillsNpc2 = visitor.canKill(npc1, npc2);
+    bool npc2KillsNpc1 = visitor.canKill(npc2, npc1);
+
+    if (npc1KillsNpc2 && npc2KillsNpc1) {
+        // Оба убивают друг друга
+        notifyObservers(BattleEvent(BattleEvent::Kind::MutualKill, npc1, npc2));
+        toRemove.push_back(npc1->getName());
+        toRemove.push_back(npc2->getName());
+    } else if (npc1KillsNpc2) {
+        // Только npc1 убивает npc2
+        notifyObservers(BattleEvent(BattleEvent::Kind::Kill, npc1, npc2));
+        toRemove.push_back(npc2->getName());
+    } else if (npc2KillsNpc1) {
+        // Только npc2 убивает npc1
+        notifyObservers(BattleEvent(BattleEvent::Kind::Kill, npc2, npc1));
+        toRemove.push_back(npc1->getName());
+    }
+}
+
+
+void Arena::startBattle(double range) {
+    CombatVisitor visitor;
+    // Имена NPC для удаления - представления имён самих NPC: каждое
+    // действительно, пока его NPC не удалён
+    std::vector<std::string_view> toRemove;
+
+    auto pairs = (battle_mode_ == BattleMode::SweepAndPrune)
+        ? findPairsSweepAndPrune(range)
+        : findPairsBruteForce(range);
+
+    for (const auto& [npc1, npc2] : pairs) {
+        resolvePair(npc1, npc2, visitor, toRemove);
+    }
     
     // Удаляем убитых NPC (убираем дубликаты)
     std::sort(toRemove.begin(), toRemove.end());
@@ -150,4 +571,8 @@ void Arena::startBattle(double range) {
     for (const auto& name : toRemove) {
         npcs_.erase(name);
     }
+
+    for (auto& observer : observers_) {
+        observer->onBattleEnd();
+    }
 }
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "../include/async_file_observer.h"
+#include <stdexcept>
+
+AsyncFileObserver::AsyncFileObserver(const std::string& filename)
+    : AsyncFileObserver(filename, Config{}) {}
+
+AsyncFileObserver::AsyncFileObserver(const std::string& filename, const Config& config)
+    : config_(config), queue_(config.capacity), accepted_(0), written_(0), dropped_(0),
+      batches_(0), kick_(false), flush_target_(0), stopping_(false) {
+    if (config_.flush_size == 0) {
+        throw std::invalid_argument("Flush size must be positive.");
+    }
+
+    file_.open(filename, std::ios::app | std::ios::binary);
+    if (!file_.is_open()) {
+        throw std::runtime_error("Failed to open file for writing: " + filename);
+    }
+
+    thread_ = std::thread(&AsyncFileObserver::run, this);
+}
+
+AsyncFileObserver::~AsyncFileObserver() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+void AsyncFileObserver::notify(const std::string& event) {
+    while (!queue_.tryPush(event)) {
+        if (config_.overflow == Overflow::Drop) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        // Очередь заполнена: будим писателя и ждём освобождения места
+        wakeWriter();
+        std::this_thread::yield();
+    }
+
+    std::uint64_t accepted = accepted_.fetch_add(1) + 1;
+    std::uint64_t written = written_.load(std::memory_order_relaxed);
+    if (accepted > written && accepted - written >= config_.flush_size && !kick_.exchange(true)) {
+        wakeWriter();
+    }
+}
+
+void AsyncFileObserver::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::uint64_t target = accepted_.load();
+    if (target > flush_target_) flush_target_ = target;
+    wake_.notify_one();
+    flushed_.wait(lock, [this, target] { return written_.load() >= target; });
+}
+
+const AsyncFileObserver::Config& AsyncFileObserver::getConfig() const {
+    return config_;
+}
+
+std::uint64_t AsyncFileObserver::getWritten() const {
+    return written_.load();
+}
+
+std::uint64_t AsyncFileObserver::getDropped() const {
+    return dropped_.load();
+}
+
+std::uint64_t AsyncFileObserver::getBatches() const {
+    return batches_.load();
+}
+
+void AsyncFileObserver::wakeWriter() {
+    // Пустая критическая секция: писатель либо уже проверяет условие под
+    // мьютексом и увидит новое состояние, либо ждёт и получит notify
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    wake_.notify_one();
+}
+
+void AsyncFileObserver::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait_for(lock, config_.flush_interval, [this] {
+            return stopping_ || kick_.load() || flush_target_ > written_.load();
+        });
+        bool stop = stopping_;
+        std::uint64_t target = stop ? accepted_.load() : flush_target_;
+        lock.unlock();
+
+        kick_.store(false);
+        writeUntil(target);
+
+        lock.lock();
+        flushed_.notify_all();
+        if (stop) return;
+    }
+}
+
+void AsyncFileObserver::writeUntil(std::uint64_t target) {
+    std::uint64_t done = written_.load();
+
+    // Забираем всё, что есть в очереди, и не меньше target событий:
+    // запись, начатая другим потоком до flush, может ещё не быть видна.
+    // Блок не больше ёмкости очереди, чтобы память оставалась ограниченной.
+    while (true) {
+        batch_.clear();
+        size_t count = queue_.tryPopBatch(batch_, queue_.capacity());
+        if (count == 0) {
+            if (done >= target) return;
+            std::this_thread::yield();
+            continue;
+        }
+
+        buffer_.clear();
+        for (const std::string& event : batch_) {
+            buffer_ += event;
+            buffer_ += '\n';
+        }
+        file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        file_.flush();
+
+        done += count;
+        batches_.fetch_add(1, std::memory_order_relaxed);
+        written_.store(done);
+
+        if (done >= target && count < queue_.capacity()) return;
+    }
+}
@@ -0,0 +1,29 @@
+#include "../include/battle_event.h"
+#include "../include/npc.h"
+
+namespace {
+
+void appendNpc(const Npc& npc, std::string& out) {
+    out += npc.getName();
+    out += " (";
+    out += npc.getType();
+    out += ')';
+}
+
+}
+
+const std::string& BattleEvent::text() const {
+    if (text_.empty()) {
+        appendTo(text_);
+    }
+    return text_;
+}
+
+void BattleEvent::appendTo(std::string& out) const {
+    appendNpc(*attacker, out);
+    out += kind == Kind::MutualKill ? " and " : " killed ";
+    appendNpc(*defender, out);
+    if (kind == Kind::MutualKill) {
+        out += " killed each other";
+    }
+}
@@ -0,0 +1,134 @@
+#include "../include/binary_scenario.h"
+#include <fstream>
+#include <stdexcept>
+
+namespace binary_scenario {
+
+namespace {
+
+constexpr std::uint64_t kAlignment = 8;
+
+std::uint64_t alignUp(std::uint64_t offset) {
+    return (offset + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+void corrupted(const std::string& reason) {
+    throw std::runtime_error("Corrupted scenario file: " + reason);
+}
+
+}
+
+bool hasMagic(std::string_view data) {
+    return data.size() >= sizeof(kMagic) &&
+           std::memcmp(data.data(), kMagic, sizeof(kMagic)) == 0;
+}
+
+void write(const std::string& filename, const Columns& columns) {
+    const std::uint64_t count = columns.types.size();
+    if (columns.coords.size() != count || columns.names.size() != count) {
+        throw std::invalid_argument("Scenario columns have different sizes.");
+    }
+
+    // Таблица строк и смещения имён
+    std::vector<std::uint64_t> name_offsets;
+    name_offsets.reserve(count + 1);
+    std::uint64_t names_size = 0;
+    for (std::string_view name : columns.names) {
+        name_offsets.push_back(names_size);
+        names_size += name.size();
+    }
+    name_offsets.push_back(names_size);
+
+    std::string names;
+    names.reserve(names_size);
+    for (std::string_view name : columns.names) {
+        names.append(name);
+    }
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.byte_order = kByteOrderMark;
+    header.count = count;
+    header.types_offset = sizeof(Header);
+    header.coords_offset = alignUp(header.types_offset + count);
+    header.name_offsets_offset = alignUp(header.coords_offset + count * sizeof(Coord));
+    header.names_offset = header.name_offsets_offset + (count + 1) * sizeof(std::uint64_t);
+    header.names_size = names_size;
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file for writing: " + filename);
+    }
+
+    // Каждая колонка - одна запись; между колонками нули до выравнивания
+    const char padding[kAlignment] = {};
+    auto pad = [&](std::uint64_t written, std::uint64_t target) {
+        file.write(padding, static_cast<std::streamsize>(target - written));
+    };
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(columns.types.data()), static_cast<std::streamsize>(count));
+    pad(header.types_offset + count, header.coords_offset);
+    file.write(reinterpret_cast<const char*>(columns.coords.data()),
+               static_cast<std::streamsize>(count * sizeof(Coord)));
+    pad(header.coords_offset + count * sizeof(Coord), header.name_offsets_offset);
+    file.write(reinterpret_cast<const char*>(name_offsets.data()),
+               static_cast<std::streamsize>(name_offsets.size() * sizeof(std::uint64_t)));
+    file.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+    if (!file) {
+        throw std::runtime_error("Failed to write file: " + filename);
+    }
+}
+
+View::View(std::string_view data) {
+    if (data.size() < sizeof(Header) || !hasMagic(data)) {
+        corrupted("missing header");
+    }
+
+    Header header;
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    if (header.byte_order != kByteOrderMark) {
+        throw std::runtime_error("Scenario file has a different byte order.");
+    }
+    if (header.version != kVersion) {
+        throw std::runtime_error("Unsupported scenario file version: " + std::to_string(header.version));
+    }
+
+    // Все колонки должны помещаться в файл; count ограничен размером файла,
+    // поэтому произведения ниже не переполняются
+    const std::uint64_t size = data.size();
+    const std::uint64_t count = header.count;
+    auto fits = [size](std::uint64_t offset, std::uint64_t length) {
+        return offset <= size && length <= size - offset;
+    };
+
+    if (count > size ||
+        !fits(header.types_offset, count) ||
+        !fits(header.coords_offset, count * sizeof(Coord)) ||
+        !fits(header.name_offsets_offset, (count + 1) * sizeof(std::uint64_t)) ||
+        !fits(header.names_offset, header.names_size)) {
+        corrupted("column out of range");
+    }
+
+    count_ = static_cast<size_t>(count);
+    types_ = data.data() + header.types_offset;
+    coords_ = data.data() + header.coords_offset;
+    name_offsets_ = data.data() + header.name_offsets_offset;
+    names_ = data.data() + header.names_offset;
+
+    // Смещения имён не убывают и не выходят за таблицу строк
+    std::uint64_t previous = 0;
+    for (size_t i = 0; i <= count_; ++i) {
+        std::uint64_t offset;
+        std::memcpy(&offset, name_offsets_ + i * sizeof(std::uint64_t), sizeof(offset));
+        if (offset < previous || offset > header.names_size || (i == 0 && offset != 0)) {
+            corrupted("bad name offset");
+        }
+        previous = offset;
+    }
+}
+
+}
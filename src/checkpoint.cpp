@@ -0,0 +1,427 @@
+#include "../include/checkpoint.h"
+#include "../include/mapped_file.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace checkpoint {
+
+namespace {
+
+constexpr std::uint64_t kAlignment = 8;
+
+std::uint64_t alignUp(std::uint64_t offset) {
+    return (offset + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+void corrupted(const std::string& filename, const std::string& reason) {
+    throw std::runtime_error("Corrupted checkpoint " + filename + ": " + reason);
+}
+
+// Последовательное чтение колонок из отображённого файла с проверкой границ
+class Reader {
+    public:
+        Reader(const MappedFile& file, const std::string& filename)
+            : data_(file.data()), size_(file.size()), offset_(0), filename_(filename) {}
+
+        void read(void* out, std::uint64_t bytes) {
+            if (bytes > size_ - offset_) corrupted(filename_, "unexpected end of file");
+            std::memcpy(out, data_ + offset_, bytes);
+            offset_ += bytes;
+        }
+
+        const char* take(std::uint64_t bytes) {
+            if (bytes > size_ - offset_) corrupted(filename_, "unexpected end of file");
+            const char* result = data_ + offset_;
+            offset_ += bytes;
+            return result;
+        }
+
+        void align() {
+            offset_ = std::min<std::uint64_t>(size_, alignUp(offset_));
+        }
+
+        std::uint64_t remaining() const { return size_ - offset_; }
+
+    private:
+        const char* data_;
+        std::uint64_t size_;
+        std::uint64_t offset_;
+        const std::string& filename_;
+};
+
+// Запись во временный файл <filename>.tmp, который finish() переименовывает
+// в итоговый. Прерванная запись не оставляет обрезанного файла под именем
+// точки: прежняя точка с этим именем остаётся целой.
+class Output {
+    public:
+        explicit Output(const std::string& filename)
+            : temp_(filename + ".tmp"), file_(temp_, std::ios::binary | std::ios::trunc),
+              filename_(filename), offset_(0), finished_(false) {
+            if (!file_.is_open()) {
+                throw std::runtime_error("Failed to open file for writing: " + filename);
+            }
+        }
+
+        ~Output() {
+            if (!finished_) {
+                file_.close();
+                std::error_code error;
+                std::filesystem::remove(temp_, error);
+            }
+        }
+
+        void write(const void* data, std::uint64_t bytes) {
+            file_.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+            offset_ += bytes;
+        }
+
+        void align() {
+            const char padding[kAlignment] = {};
+            write(padding, alignUp(offset_) - offset_);
+        }
+
+        void finish() {
+            file_.close();
+            if (!file_) {
+                throw std::runtime_error("Failed to write file: " + filename_);
+            }
+
+            std::error_code error;
+            std::filesystem::rename(temp_, filename_, error);
+            if (error) {
+                throw std::runtime_error("Failed to write file: " + filename_ + ": " + error.message());
+            }
+            finished_ = true;
+        }
+
+    private:
+        std::string temp_;
+        std::ofstream file_;
+        const std::string& filename_;
+        std::uint64_t offset_;
+        bool finished_;
+};
+
+Header makeHeader(Kind kind, const WorldSnapshot& snapshot, std::uint64_t seed) {
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.byte_order = kByteOrderMark;
+    header.kind = kind;
+    header.width = snapshot.width;
+    header.height = snapshot.height;
+    header.tick = snapshot.tick;
+    header.seed = seed;
+    header.count = snapshot.size();
+    return header;
+}
+
+void writeFull(const std::string& filename, const WorldSnapshot& snapshot, std::uint64_t seed) {
+    const std::vector<std::string>& names = *snapshot.names;
+    const size_t count = snapshot.size();
+
+    Header header = makeHeader(Kind::Full, snapshot, seed);
+    header.base_tick = snapshot.tick;
+    header.records = count;
+
+    std::vector<std::uint64_t> name_offsets;
+    name_offsets.reserve(count + 1);
+    std::string blob;
+    for (size_t i = 0; i < count; ++i) {
+        name_offsets.push_back(blob.size());
+        blob += names[i];
+    }
+    name_offsets.push_back(blob.size());
+    header.names_size = blob.size();
+
+    // Координаты парами, как в двоичном сценарии
+    std::vector<std::int32_t> coords(count * 2);
+    for (size_t i = 0; i < count; ++i) {
+        coords[2 * i] = snapshot.xs[i];
+        coords[2 * i + 1] = snapshot.ys[i];
+    }
+
+    Output out(filename);
+    out.write(&header, sizeof(header));
+    out.write(snapshot.types.data(), count);
+    out.write(snapshot.alive.data(), count);
+    out.align();
+    out.write(coords.data(), coords.size() * sizeof(std::int32_t));
+    out.write(name_offsets.data(), name_offsets.size() * sizeof(std::uint64_t));
+    out.write(blob.data(), blob.size());
+    out.finish();
+}
+
+void writeDelta(const std::string& filename, const WorldSnapshot& snapshot,
+                const WorldSnapshot& base, std::uint64_t seed) {
+    std::vector<DeltaRecord> records;
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        if (snapshot.xs[i] != base.xs[i] || snapshot.ys[i] != base.ys[i] ||
+            snapshot.alive[i] != base.alive[i]) {
+            records.push_back({static_cast<std::uint32_t>(i), snapshot.xs[i], snapshot.ys[i],
+                               snapshot.alive[i]});
+        }
+    }
+
+    Header header = makeHeader(Kind::Delta, snapshot, seed);
+    header.base_tick = base.tick;
+    header.records = records.size();
+
+    Output out(filename);
+    out.write(&header, sizeof(header));
+    out.write(records.data(), records.size() * sizeof(DeltaRecord));
+    out.finish();
+}
+
+Header readHeader(Reader& reader, const std::string& filename) {
+    Header header;
+    reader.read(&header, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        corrupted(filename, "missing header");
+    }
+    if (header.byte_order != kByteOrderMark) {
+        throw std::runtime_error("Checkpoint " + filename + " has a different byte order.");
+    }
+    if (header.version != kVersion) {
+        throw std::runtime_error("Unsupported checkpoint version: " + std::to_string(header.version));
+    }
+    return header;
+}
+
+void readFull(Reader& reader, const Header& header, const std::string& filename, State& state) {
+    // count ограничен размером файла, поэтому произведения не переполняются
+    const std::uint64_t count = header.count;
+    if (header.records != count || count > reader.remaining()) {
+        corrupted(filename, "bad record count");
+    }
+
+    state.types.resize(count);
+    state.alive.resize(count);
+    reader.read(state.types.data(), count);
+    reader.read(state.alive.data(), count);
+    reader.align();
+
+    const char* coords = reader.take(count * 2 * sizeof(std::int32_t));
+    state.xs.resize(count);
+    state.ys.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::int32_t xy[2];
+        std::memcpy(xy, coords + i * sizeof(xy), sizeof(xy));
+        state.xs[i] = xy[0];
+        state.ys[i] = xy[1];
+    }
+
+    std::vector<std::uint64_t> offsets(count + 1);
+    reader.read(offsets.data(), offsets.size() * sizeof(std::uint64_t));
+    const char* blob = reader.take(header.names_size);
+
+    state.names.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (offsets[i] > offsets[i + 1] || offsets[i + 1] > header.names_size) {
+            corrupted(filename, "bad name offset");
+        }
+        state.names[i].assign(blob + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+}
+
+void readDelta(Reader& reader, const Header& header, const std::string& filename, State& state) {
+    if (header.base_tick != state.tick || header.count != state.types.size() ||
+        header.seed != state.seed || header.width != state.width || header.height != state.height) {
+        throw std::runtime_error("Checkpoint chain is broken at " + filename);
+    }
+    if (header.records > reader.remaining() / sizeof(DeltaRecord)) {
+        corrupted(filename, "bad record count");
+    }
+
+    const char* records = reader.take(header.records * sizeof(DeltaRecord));
+    for (std::uint64_t k = 0; k < header.records; ++k) {
+        DeltaRecord record;
+        std::memcpy(&record, records + k * sizeof(DeltaRecord), sizeof(record));
+        if (record.index >= state.types.size()) {
+            corrupted(filename, "record index out of range");
+        }
+        state.xs[record.index] = record.x;
+        state.ys[record.index] = record.y;
+        state.alive[record.index] = record.alive != 0 ? 1 : 0;
+    }
+}
+
+}
+
+void write(const std::string& filename, const WorldSnapshot& snapshot,
+           const WorldSnapshot* base, std::uint64_t seed) {
+    if (base && base->size() == snapshot.size()) {
+        writeDelta(filename, snapshot, *base, seed);
+    } else {
+        writeFull(filename, snapshot, seed);
+    }
+}
+
+std::vector<std::string> findChain(const std::string& prefix) {
+    namespace fs = std::filesystem;
+    const fs::path base(prefix);
+    const fs::path directory = base.parent_path().empty() ? fs::path(".") : base.parent_path();
+    const std::string stem = base.filename().string() + "-";
+    const std::string suffix = ".ckpt";
+
+    struct Candidate {
+        std::string file;
+        Header header;
+    };
+
+    // Заголовки всех точек с этим префиксом; нечитаемые файлы пропускаются
+    std::vector<Candidate> found;
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(directory, error)) {
+        std::string name = entry.path().filename().string();
+        if (name.size() <= stem.size() + suffix.size() || !name.starts_with(stem) || !name.ends_with(suffix)) {
+            continue;
+        }
+
+        std::string file = (base.parent_path() / name).string();
+        try {
+            MappedFile mapped(file);
+            Reader reader(mapped, file);
+            found.push_back({file, readHeader(reader, file)});
+        } catch (const std::exception&) {
+            // Не точка этого формата - не звено цепочки
+        }
+    }
+
+    std::sort(found.begin(), found.end(), [](const Candidate& a, const Candidate& b) {
+        return a.header.tick > b.header.tick;
+    });
+
+    // От самой поздней точки назад по base_tick до полной; если звено
+    // пропало, берётся следующая по времени точка
+    for (const Candidate& last : found) {
+        std::vector<std::string> chain = {last.file};
+        const Candidate* current = &last;
+        while (current && current->header.kind == Kind::Delta) {
+            const Candidate* previous = nullptr;
+            for (const Candidate& candidate : found) {
+                const Header& h = candidate.header;
+                if (h.tick == current->header.base_tick && h.tick < current->header.tick &&
+                    h.seed == current->header.seed && h.count == current->header.count &&
+                    h.width == current->header.width && h.height == current->header.height) {
+                    previous = &candidate;
+                    break;
+                }
+            }
+            if (previous) chain.push_back(previous->file);
+            current = previous;
+        }
+
+        if (current) {
+            std::reverse(chain.begin(), chain.end());
+            return chain;
+        }
+    }
+    return {};
+}
+
+State load(const std::vector<std::string>& files) {
+    if (files.empty()) {
+        throw std::invalid_argument("Checkpoint chain is empty.");
+    }
+
+    State state;
+    for (size_t k = 0; k < files.size(); ++k) {
+        MappedFile file(files[k]);
+        Reader reader(file, files[k]);
+        Header header = readHeader(reader, files[k]);
+
+        if (k == 0) {
+            if (header.kind != Kind::Full) {
+                throw std::runtime_error("Checkpoint chain must start with a full checkpoint: " + files[k]);
+            }
+            state.seed = header.seed;
+            state.width = header.width;
+            state.height = header.height;
+            readFull(reader, header, files[k], state);
+        } else {
+            if (header.kind != Kind::Delta) {
+                throw std::runtime_error("Checkpoint chain is broken at " + files[k]);
+            }
+            readDelta(reader, header, files[k], state);
+        }
+        state.tick = header.tick;
+    }
+
+    return state;
+}
+
+Writer::Writer() : busy_(false), stopping_(false), written_(0) {
+    thread_ = std::thread(&Writer::run, this);
+}
+
+Writer::~Writer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+void Writer::submit(const std::string& filename,
+                    std::shared_ptr<const WorldSnapshot> snapshot,
+                    std::shared_ptr<const WorldSnapshot> base,
+                    std::uint64_t seed) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back({filename, std::move(snapshot), std::move(base), seed});
+    }
+    wake_.notify_one();
+}
+
+void Writer::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return jobs_.empty() && !busy_; });
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+std::uint64_t Writer::getWritten() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return written_;
+}
+
+void Writer::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+        if (jobs_.empty()) return;  // остановка после записи очереди
+
+        Job job = std::move(jobs_.front());
+        jobs_.pop_front();
+        busy_ = true;
+        lock.unlock();
+
+        std::exception_ptr error;
+        try {
+            write(job.filename, *job.snapshot, job.base.get(), job.seed);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        // Снимки отпускаются вне блокировки
+        job = Job{};
+        lock.lock();
+        busy_ = false;
+        if (error) {
+            if (!error_) error_ = error;
+        } else {
+            ++written_;
+        }
+        if (jobs_.empty()) idle_.notify_all();
+    }
+}
+
+}
@@ -0,0 +1,141 @@
+#include "../include/combat_kernel.h"
+#include <atomic>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define COMBAT_KERNEL_HAS_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace combat_kernel {
+
+namespace {
+
+size_t slotOf(NpcTypeId type) {
+    return toIndex(type) & CombatRules::kIndexMask;
+}
+
+size_t findHitsScalar(const Probe& probe, const Block& block, const Tables& tables,
+                      size_t begin, std::uint32_t* hits) {
+    size_t a = slotOf(probe.type);
+    size_t found = 0;
+
+    for (size_t i = begin; i < block.count; ++i) {
+        if (!block.alive[i]) continue;
+
+        size_t b = slotOf(block.types[i]);
+        int dx = block.xs[i] - probe.x;
+        int dy = block.ys[i] - probe.y;
+        int radius_sq = tables.kill_radius_sq[a] > tables.kill_radius_sq[b]
+            ? tables.kill_radius_sq[a] : tables.kill_radius_sq[b];
+        if (dx * dx + dy * dy > radius_sq) continue;
+
+        bool hostile = ((tables.kill_mask[a] >> b) & 1) || ((tables.kill_mask[b] >> a) & 1);
+        if (hostile) {
+            hits[found++] = static_cast<std::uint32_t>(i);
+        }
+    }
+
+    return found;
+}
+
+#ifdef COMBAT_KERNEL_HAS_AVX2
+__attribute__((target("avx2")))
+size_t findHitsAvx2(const Probe& probe, const Block& block, const Tables& tables,
+                    std::uint32_t* hits) {
+    const int a = static_cast<int>(slotOf(probe.type));
+    const __m256i ax = _mm256_set1_epi32(probe.x);
+    const __m256i ay = _mm256_set1_epi32(probe.y);
+    const __m256i a_radius_sq = _mm256_set1_epi32(tables.kill_radius_sq[a]);
+    const __m256i a_mask = _mm256_set1_epi32(tables.kill_mask[a]);
+    const __m128i a_shift = _mm_cvtsi32_si128(a);
+    const __m256i slot_mask = _mm256_set1_epi32(static_cast<int>(CombatRules::kIndexMask));
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i zero = _mm256_setzero_si256();
+
+    size_t found = 0;
+    size_t i = 0;
+
+    for (; i + 8 <= block.count; i += 8) {
+        __m256i bx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block.xs + i));
+        __m256i by = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block.ys + i));
+        __m256i dx = _mm256_sub_epi32(bx, ax);
+        __m256i dy = _mm256_sub_epi32(by, ay);
+        __m256i dist_sq = _mm256_add_epi32(_mm256_mullo_epi32(dx, dx), _mm256_mullo_epi32(dy, dy));
+
+        // type_id и alive - по байту на NPC, расширяем до 32 бит
+        __m256i b = _mm256_and_si256(_mm256_cvtepu8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(block.types + i))), slot_mask);
+        __m256i alive = _mm256_cvtepu8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(block.alive + i)));
+
+        __m256i b_radius_sq = _mm256_i32gather_epi32(tables.kill_radius_sq, b, 4);
+        __m256i radius_sq = _mm256_max_epi32(a_radius_sq, b_radius_sq);
+        __m256i too_far = _mm256_cmpgt_epi32(dist_sq, radius_sq);
+
+        __m256i a_kills_b = _mm256_and_si256(_mm256_srlv_epi32(a_mask, b), one);
+        __m256i b_mask = _mm256_i32gather_epi32(tables.kill_mask, b, 4);
+        __m256i b_kills_a = _mm256_and_si256(_mm256_srl_epi32(b_mask, a_shift), one);
+        __m256i hostile = _mm256_cmpeq_epi32(_mm256_or_si256(a_kills_b, b_kills_a), one);
+
+        __m256i selected = _mm256_andnot_si256(too_far,
+            _mm256_and_si256(hostile, _mm256_cmpgt_epi32(alive, zero)));
+
+        unsigned bits = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(selected)));
+        while (bits) {
+            hits[found++] = static_cast<std::uint32_t>(i + __builtin_ctz(bits));
+            bits &= bits - 1;
+        }
+    }
+
+    // Хвост блока короче 8 элементов
+    return found + findHitsScalar(probe, block, tables, i, hits + found);
+}
+#endif
+
+Impl detectImpl() {
+    return isAvx2Supported() ? Impl::Avx2 : Impl::Scalar;
+}
+
+std::atomic<Impl> current_impl{detectImpl()};
+
+}
+
+Tables makeTables(const CombatRules& rules) {
+    Tables tables{};
+    for (size_t i = 0; i < CombatRules::kMaxTypes; ++i) {
+        NpcTypeId type = static_cast<NpcTypeId>(i);
+        int radius = rules.getStats(type).kill_distance;
+        tables.kill_radius_sq[i] = radius * radius;
+        tables.kill_mask[i] = rules.getKillMask(type);
+    }
+    return tables;
+}
+
+size_t findHits(const Probe& probe, const Block& block, const Tables& tables,
+                std::uint32_t* hits) {
+#ifdef COMBAT_KERNEL_HAS_AVX2
+    if (current_impl.load(std::memory_order_relaxed) == Impl::Avx2) {
+        return findHitsAvx2(probe, block, tables, hits);
+    }
+#endif
+    return findHitsScalar(probe, block, tables, 0, hits);
+}
+
+Impl getImpl() {
+    return current_impl;
+}
+
+void setImpl(Impl impl) {
+    current_impl = (impl == Impl::Avx2 && !isAvx2Supported()) ? Impl::Scalar : impl;
+}
+
+bool isAvx2Supported() {
+#ifdef COMBAT_KERNEL_HAS_AVX2
+    __builtin_cpu_init();  // может вызываться до статических конструкторов libgcc
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+}
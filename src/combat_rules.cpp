@@ -0,0 +1,76 @@
+#include "../include/combat_rules.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+CombatRules active_rules = kDefaultCombatRules;
+
+NpcTypeId parseType(const std::string& name, int lineNumber) {
+    NpcTypeId type = npcTypeFromName(name);
+    if (type == NpcTypeId::Unknown) {
+        throw std::invalid_argument("Unknown NPC type in rules (line " +
+                                    std::to_string(lineNumber) + "): " + name);
+    }
+    return type;
+}
+
+}
+
+CombatRules CombatRules::loadFromFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open rules file: " + filename);
+    }
+
+    CombatRules rules;
+    std::string line;
+    int lineNumber = 0;
+
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        auto comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+
+        std::istringstream iss(line);
+        std::string keyword;
+        if (!(iss >> keyword)) continue;
+
+        if (keyword == "stats") {
+            std::string type;
+            NpcStats stats{};
+            if (!(iss >> type >> stats.movement_distance >> stats.kill_distance) ||
+                stats.movement_distance < 1 || stats.kill_distance < 0) {
+                throw std::runtime_error("Failed to read rules line " +
+                                         std::to_string(lineNumber) + ": " + line);
+            }
+            rules.setStats(parseType(type, lineNumber), stats);
+        } else if (keyword == "kills") {
+            std::string attacker, defender;
+            if (!(iss >> attacker >> defender)) {
+                throw std::runtime_error("Failed to read rules line " +
+                                         std::to_string(lineNumber) + ": " + line);
+            }
+            NpcTypeId attackerId = parseType(attacker, lineNumber);
+            do {
+                rules.setKills(attackerId, parseType(defender, lineNumber), true);
+            } while (iss >> defender);
+        } else {
+            throw std::runtime_error("Unknown rules keyword (line " +
+                                     std::to_string(lineNumber) + "): " + keyword);
+        }
+    }
+
+    return rules;
+}
+
+const CombatRules& CombatRules::active() {
+    return active_rules;
+}
+
+void CombatRules::setActive(const CombatRules& rules) {
+    active_rules = rules;
+}
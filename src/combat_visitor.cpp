@@ -1,24 +1,15 @@
 #include "../include/combat_visitor.h"
+#include "../include/combat_rules.h"
 
 bool CombatVisitor::canKill(Npc* attacker, Npc* defender) {
-    if (attacker->getType() == "Knight") {
-        return knightVs(defender->getType());
-    } else if (attacker->getType() == "Druid") {
-        return druidVs(defender->getType());
-    } else if (attacker->getType() == "Elf") {
-        return elfVs(defender->getType());
-    }
-    return false;
+    return canKill(attacker->getTypeId(), defender->getTypeId());
 }
 
-bool CombatVisitor::knightVs(const std::string& defenderType) {
-    return (defenderType == "Elf");
+bool CombatVisitor::canKill(const std::string& attackerType, const std::string& defenderType) {
+    return canKill(npcTypeFromName(attackerType), npcTypeFromName(defenderType));
 }
 
-bool CombatVisitor::druidVs(const std::string& defenderType) {
-    return (defenderType == "Druid");
-}
-
-bool CombatVisitor::elfVs(const std::string& defenderType) {
-    return (defenderType == "Druid" || defenderType == "Knight");
+bool CombatVisitor::canKill(NpcTypeId attacker, NpcTypeId defender) {
+    // Таблица правил вместо цепочек if по типам
+    return CombatRules::active().canKill(attacker, defender);
 }
\ No newline at end of file
@@ -3,9 +3,7 @@
 #include <iostream>
 
 Druid::Druid(int x, int y, const std::string& name)
-    : Npc(x, y, kType, name) {}
-
-const std::string Druid::kType = "Druid";
+    : Npc(x, y, NpcTypeId::Druid, name) {}
 
 
 void Druid::accept(Visitor& visitor) {
@@ -3,9 +3,7 @@
 #include <iostream>
 
 Elf::Elf(int x, int y, const std::string& name)
-    : Npc(x, y, kType, name) {}
-
-const std::string Elf::kType = "Elf";
+    : Npc(x, y, NpcTypeId::Elf, name) {}
 
 void Elf::accept(Visitor& visitor) {
     visitor.visit(*this);
@@ -0,0 +1,212 @@
+#include "../include/event_sink.h"
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+std::atomic<std::uint64_t> next_sink_id{1};
+
+// Буферы текущего потока по номерам журналов. Записи журналов, которых уже
+// нет, остаются, но номер больше никогда не совпадёт
+template <typename Buffer>
+std::vector<std::pair<std::uint64_t, Buffer*>>& threadBuffers() {
+    thread_local std::vector<std::pair<std::uint64_t, Buffer*>> buffers;
+    return buffers;
+}
+
+void formatPlain(const EventRecord& record, std::string_view text, std::string& out) {
+    if (record.kind == EventKind::Text) {
+        out += text;
+    } else {
+        out += std::to_string(record.attacker);
+        out += " killed ";
+        out += std::to_string(record.defender);
+    }
+    out += '\n';
+}
+
+}
+
+EventSink::EventSink(std::ostream& out) : EventSink(out, Config{}) {}
+
+EventSink::EventSink(std::ostream& out, const Config& config)
+    : out_(out), config_(config), id_(next_sink_id.fetch_add(1)), written_(0),
+      kick_(false), stopping_(false), flush_requested_(0), flush_done_(0) {
+    if (config_.records_per_thread == 0) {
+        throw std::invalid_argument("Event buffer capacity must be positive.");
+    }
+
+    sources_.push_back(formatPlain);
+    spare_records_.reserve(config_.records_per_thread);
+    thread_ = std::thread(&EventSink::run, this);
+}
+
+EventSink::~EventSink() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+std::shared_ptr<EventSink> EventSink::console() {
+    static std::shared_ptr<EventSink> sink = std::make_shared<EventSink>(std::cout);
+    return sink;
+}
+
+std::uint32_t EventSink::addSource(Formatter formatter) {
+    std::lock_guard<std::mutex> lock(sources_mutex_);
+    sources_.push_back(std::move(formatter));
+    return static_cast<std::uint32_t>(sources_.size() - 1);
+}
+
+void EventSink::removeSource(std::uint32_t source) {
+    flush();
+    std::lock_guard<std::mutex> lock(sources_mutex_);
+    if (source != kPlainText && source < sources_.size()) {
+        sources_[source] = nullptr;
+    }
+}
+
+void EventSink::push(const EventRecord& record) {
+    ThreadBuffer& buffer = lockBuffer(1, 0);
+    buffer.records.push_back(record);
+    bool half = buffer.records.size() == config_.records_per_thread / 2;
+    buffer.busy.clear(std::memory_order_release);
+
+    if (half) wakeConsumer();
+}
+
+void EventSink::pushText(std::string_view text, std::uint32_t source, std::uint64_t tick) {
+    ThreadBuffer& buffer = lockBuffer(1, text.size());
+    buffer.records.push_back({tick, static_cast<std::uint32_t>(buffer.text.size()),
+                              static_cast<std::uint32_t>(text.size()), source, EventKind::Text});
+    size_t before = buffer.text.size();
+    buffer.text.append(text);
+    size_t half_text = config_.text_per_thread / 2;
+    bool half = buffer.records.size() == config_.records_per_thread / 2 ||
+                (before < half_text && buffer.text.size() >= half_text);
+    buffer.busy.clear(std::memory_order_release);
+
+    if (half) wakeConsumer();
+}
+
+void EventSink::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::uint64_t ticket = ++flush_requested_;
+    wake_.notify_one();
+    flushed_.wait(lock, [this, ticket] { return flush_done_ >= ticket; });
+}
+
+std::uint64_t EventSink::getWritten() const {
+    return written_.load();
+}
+
+EventSink::ThreadBuffer& EventSink::localBuffer() {
+    auto& buffers = threadBuffers<ThreadBuffer>();
+    for (const auto& [id, buffer] : buffers) {
+        if (id == id_) return *buffer;
+    }
+
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->records.reserve(config_.records_per_thread);
+    ThreadBuffer* raw = buffer.get();
+    {
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        buffers_.push_back(std::move(buffer));
+    }
+    buffers.emplace_back(id_, raw);
+    return *raw;
+}
+
+EventSink::ThreadBuffer& EventSink::lockBuffer(size_t records, size_t text) {
+    ThreadBuffer& buffer = localBuffer();
+    for (;;) {
+        // Потребитель держит блокировку только на время обмена векторов
+        while (buffer.busy.test_and_set(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+
+        // Строка длиннее лимита всё равно принимается в пустой буфер
+        bool fits = buffer.records.size() + records <= config_.records_per_thread &&
+                    (buffer.text.empty() || buffer.text.size() + text <= config_.text_per_thread);
+        if (fits) return buffer;
+
+        buffer.busy.clear(std::memory_order_release);
+        wakeConsumer();
+        std::this_thread::yield();
+    }
+}
+
+void EventSink::wakeConsumer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        kick_ = true;
+    }
+    wake_.notify_one();
+}
+
+void EventSink::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait_for(lock, config_.flush_interval, [this] {
+            return stopping_ || kick_ || flush_requested_ != flush_done_;
+        });
+        bool stop = stopping_;
+        std::uint64_t requested = flush_requested_;
+        kick_ = false;
+        lock.unlock();
+
+        drain();
+
+        lock.lock();
+        flush_done_ = requested;
+        flushed_.notify_all();
+        if (stop) return;
+    }
+}
+
+void EventSink::drain() {
+    // Буферы только добавляются, указатели на них стабильны
+    std::vector<ThreadBuffer*> buffers;
+    {
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        buffers.reserve(buffers_.size());
+        for (const auto& buffer : buffers_) buffers.push_back(buffer.get());
+    }
+
+    output_.clear();
+    {
+        std::lock_guard<std::mutex> sources_lock(sources_mutex_);
+        for (ThreadBuffer* buffer : buffers) {
+            while (buffer->busy.test_and_set(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            buffer->records.swap(spare_records_);
+            buffer->text.swap(spare_text_);
+            buffer->busy.clear(std::memory_order_release);
+
+            std::string_view text_block(spare_text_);
+            for (const EventRecord& record : spare_records_) {
+                std::string_view text;
+                if (record.kind == EventKind::Text) {
+                    text = text_block.substr(record.attacker, record.defender);
+                }
+                if (record.source < sources_.size() && sources_[record.source]) {
+                    sources_[record.source](record, text, output_);
+                }
+            }
+
+            written_.fetch_add(spare_records_.size(), std::memory_order_relaxed);
+            spare_records_.clear();
+            spare_text_.clear();
+        }
+    }
+
+    if (!output_.empty()) {
+        out_.write(output_.data(), static_cast<std::streamsize>(output_.size()));
+        out_.flush();
+    }
+}
@@ -4,36 +4,68 @@
 #include "../include/knight.h"
 #include "../include/druid.h"
 #include "../include/elf.h"
-#include <sstream>
+#include "../include/text_scenario.h"
+#include <new>
 #include <stdexcept>
 
-std::unique_ptr<Npc> NpcFactory::createNpc(
+namespace {
+
+template <typename T>
+NpcPtr makeNpc(std::pmr::memory_resource* memory, int x, int y, const std::string& name) {
+    if (!memory) {
+        return NpcPtr(new T(x, y, name));
+    }
+
+    void* block = memory->allocate(sizeof(T), kNpcAlignment);
+    try {
+        return NpcPtr(new (block) T(x, y, name), NpcDeleter(memory, sizeof(T)));
+    } catch (...) {
+        memory->deallocate(block, sizeof(T), kNpcAlignment);
+        throw;
+    }
+}
+
+}
+
+NpcPtr NpcFactory::createNpc(
     const std::string& type,
     const std::string& name,
     int x,
-    int y)
+    int y,
+    std::pmr::memory_resource* memory)
     {
-        if (type == "Knight") {
-            return std::make_unique<Knight>(x, y, name);
-        } else if (type == "Druid") {
-            return std::make_unique<Druid>(x, y, name);
-        } else if (type == "Elf") {
-            return std::make_unique<Elf>(x, y, name);
-        } else {
+        NpcTypeId id = npcTypeFromName(type);
+        if (id == NpcTypeId::Unknown) {
             throw std::invalid_argument("Unknown NPC type: " + type);
-        }   
+        }
+        return createNpc(id, name, x, y, memory);
     }
 
-std::unique_ptr<Npc> NpcFactory::createFromString(const std::string& line) {
-    std::istringstream iss(line);
-    std::string type, name;
-    int x, y;
+NpcPtr NpcFactory::createNpc(
+    NpcTypeId type,
+    const std::string& name,
+    int x,
+    int y,
+    std::pmr::memory_resource* memory)
+    {
+        switch (type) {
+            case NpcTypeId::Knight:
+                return makeNpc<Knight>(memory, x, y, name);
+            case NpcTypeId::Druid:
+                return makeNpc<Druid>(memory, x, y, name);
+            case NpcTypeId::Elf:
+                return makeNpc<Elf>(memory, x, y, name);
+            default:
+                throw std::invalid_argument("Unknown NPC type id: " +
+                                            std::to_string(static_cast<int>(type)));
+        }
+    }
 
-    iss >> type >> name >> x >> y;
-    
-    if (iss.fail()) {
+NpcPtr NpcFactory::createFromString(const std::string& line, std::pmr::memory_resource* memory) {
+    text_scenario::Record record;
+    if (!text_scenario::parseLine(line, record)) {
         throw std::runtime_error("Failed to read line: " + line);
     }
 
-    return createNpc(type, name, x ,y);
-}
\ No newline at end of file
+    return createNpc(std::string(record.type), std::string(record.name), record.x, record.y, memory);
+}
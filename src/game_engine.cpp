@@ -3,104 +3,534 @@
 #include <iostream>
 #include <random>
 #include <cmath>
-#include <iomanip>
 #include <algorithm>
+#include <charconv>
+#include <stdexcept>
+#include <thread>
 
-GameEngine::GameEngine(int width, int height)
-    : width_(width), height_(height), running_(false) {}
+GameEngine::GameEngine(int width, int height, std::pmr::memory_resource* memory)
+    : width_(width), height_(height), memory_(memory),
+      rules_(CombatRules::active()),
+      kernel_tables_(combat_kernel::makeTables(rules_)),
+      grid_(width, height, maxKillDistance()),
+      detection_mode_(DetectionMode::Grid),
+      combat_queue_(kCombatQueueCapacity),
+      duplicates_dropped_(0),
+      worker_count_(std::max(1u, std::thread::hardware_concurrency())),
+      seed_(0),
+      execution_mode_(ExecutionMode::Threaded),
+      scheduled_npcs_(0),
+      tick_(0),
+      snapshot_names_version_(0),
+      world_version_(1),
+      render_mode_(MapRenderer::Mode::Full),
+      events_(EventSink::console()),
+      event_names_version_(0) {
+    std::random_device rd;
+    seed_ = (static_cast<std::uint64_t>(rd()) << 32) | rd();
+    events_source_ = addEventSource(*events_);
+}
 
 GameEngine::~GameEngine() {
-    running_ = false;
-    if (movement_thread_.joinable()) movement_thread_.join();
-    if (combat_thread_.joinable()) combat_thread_.join();
-    if (display_thread_.joinable()) display_thread_.join();
+    // Источник ссылается на движок: записи выводятся, пока он жив
+    events_->removeSource(events_source_);
+}
+
+void GameEngine::setEventSink(std::shared_ptr<EventSink> sink) {
+    if (!sink) {
+        throw std::invalid_argument("Event sink must not be null.");
+    }
+    events_->removeSource(events_source_);
+    events_ = std::move(sink);
+    events_source_ = addEventSource(*events_);
+}
+
+std::pmr::memory_resource* GameEngine::getMemoryResource() const {
+    return memory_;
+}
+
+std::shared_ptr<EventSink> GameEngine::getEventSink() const {
+    return events_;
+}
+
+void GameEngine::flushEvents() const {
+    events_->flush();
+}
+
+std::uint32_t GameEngine::addEventSource(EventSink& sink) {
+    using Names = std::shared_ptr<const std::vector<std::string>>;
+    return sink.addSource([this, names = Names(), version = std::uint64_t{0}](
+                              const EventRecord& record, std::string_view, std::string& out) mutable {
+        // Движок публикует имена до записей об убийствах, поэтому здесь
+        // хватает атомарной загрузки: поток журнала не ждёт симуляцию
+        std::uint64_t current = event_names_version_.load(std::memory_order_acquire);
+        if (!names || version != current) {
+            names = event_names_.load(std::memory_order_acquire);
+            version = current;
+        }
+        if (!names || std::max(record.attacker, record.defender) >= names->size()) return;
+
+        out += "[COMBAT] ";
+        out += (*names)[record.attacker];
+        out += " killed ";
+        out += (*names)[record.defender];
+        out += '\n';
+    });
+}
+
+void GameEngine::shareEventNames() {
+    std::uint64_t version = world_version_.load(std::memory_order_acquire);
+    if (event_names_version_.load(std::memory_order_acquire) == version) return;
+
+    std::lock_guard<std::mutex> snapshot_lock(snapshot_mutex_);
+    event_names_.store(currentNames(), std::memory_order_release);
+    event_names_version_.store(version, std::memory_order_release);
+}
+
+ThreadPool& GameEngine::pool() const {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    if (!pool_) {
+        pool_ = std::make_unique<ThreadPool>(worker_count_);
+    }
+    return *pool_;
+}
+
+void GameEngine::setWorkerCount(size_t count) {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    worker_count_ = std::max<size_t>(1, count);
+    pool_.reset();
+}
+
+size_t GameEngine::getWorkerCount() const {
+    return worker_count_;
+}
+
+void GameEngine::setSeed(std::uint64_t seed) {
+    seed_ = seed;
+}
+
+std::uint64_t GameEngine::getSeed() const {
+    return seed_;
+}
+
+void GameEngine::setExecutionMode(ExecutionMode mode) {
+    execution_mode_ = mode;
+    scheduler_.clear();
+}
+
+GameEngine::ExecutionMode GameEngine::getExecutionMode() const {
+    return execution_mode_;
+}
+
+int GameEngine::maxKillDistance() const {
+    // Сторона ячейки сетки: пары дальше этого расстояния в бой не вступают
+    return std::max(1, rules_.maxKillDistance());
+}
+
+void GameEngine::setDetectionMode(DetectionMode mode) {
+    detection_mode_ = mode;
 }
 
-GameEngine::NpcStats GameEngine::getStats(const std::string& type) const {
-    if (type == "Knight") return {30, 10};
-    if (type == "Druid") return {10, 10};
-    if (type == "Elf") return {10, 50};
-    return {0, 0};
+GameEngine::DetectionMode GameEngine::getDetectionMode() const {
+    return detection_mode_;
 }
 
-void GameEngine::addNpc(std::unique_ptr<Npc> npc) {
+void GameEngine::addNpc(NpcPtr npc) {
     std::unique_lock<std::shared_mutex> lock(npcs_mutex_);
-    npcs_[npc->getName()] = std::move(npc);
+
+    // Убитые в прошлом шаге ещё стоят в сетке по прежним позициям: убираем
+    // их до того, как слот перезапишется новым NPC с тем же именем
+    removeDeadFromGrid();
+
+    // Повторное имя заменяет прежнего NPC
+    WorldStore::Index existing = world_.find(npc->getName());
+    if (existing != WorldStore::kNotFound && world_.isAlive(existing)) {
+        grid_.remove(existing, world_.getX(existing), world_.getY(existing));
+    }
+
+    WorldStore::Index i = world_.add(npc->getName(), npc->getTypeId(),
+                                     npc->getX(), npc->getY(), npc->isAlive());
+    if (i == npc_objects_.size()) {
+        npc_objects_.push_back(std::move(npc));
+    } else {
+        npc_objects_[i] = std::move(npc);
+    }
+
+    if (world_.isAlive(i)) {
+        grid_.insert(i, world_.getX(i), world_.getY(i));
+    }
+
+    // Снимок устарел; пересоберётся при чтении или после шага
+    world_version_.fetch_add(1, std::memory_order_release);
 }
 
 void GameEngine::createRandomNpcs(int count) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> x_dist(0, width_ - 1);
-    std::uniform_int_distribution<> y_dist(0, height_ - 1);
+    spawnNpcs(static_cast<size_t>(std::max(0, count)));
+}
+
+void GameEngine::spawnNpcs(size_t count) {
+    spawnNpcs(count, SpawnConfig{});
+}
+
+void GameEngine::spawnNpcs(size_t count, const SpawnConfig& config) {
+    if (count == 0) return;
+    if (config.distribution != SpawnDistribution::Uniform && (config.clusters <= 0 || config.spread < 0.0)) {
+        throw std::invalid_argument("Spawn clusters must be positive and spread non-negative.");
+    }
+
+    // Поток Spawn: i-й NPC вызова зависит только от зерна и числа NPC до вызова.
+    // Блокировка держится до конца вставки: между чтением числа NPC и
+    // вставкой другой addNpc / spawnNpcs не должен менять мир
+    std::unique_lock<std::shared_mutex> lock(npcs_mutex_);
+    const std::uint64_t first = world_.size();
+    removeDeadFromGrid();  // до замены слотов, как в addNpc
+
+    const NpcTypeId types[] = {
+        NpcTypeId::Knight, NpcTypeId::Druid, NpcTypeId::Elf
+    };
 
-    std::vector<std::string> types = {
-        "Knight", "Druid", "Elf"
+    // Центры скоплений - отдельный ключ (шаг 1 + first), чтобы не совпасть
+    // с ключами NPC (шаг 0)
+    struct Point {
+        double x;
+        double y;
     };
+    std::vector<Point> centres;
+    if (config.distribution != SpawnDistribution::Uniform) {
+        for (int c = 0; c < config.clusters; ++c) {
+            rng::CounterRng gen(seed_, rng::Stream::Spawn, 1 + first, static_cast<std::uint64_t>(c));
+            centres.push_back({static_cast<double>(gen.uniform(0, width_ - 1)),
+                               static_cast<double>(gen.uniform(0, height_ - 1))});
+        }
+    }
+    double spread = config.spread * std::min(width_, height_);
+    int half = static_cast<int>(spread);
+
+    std::vector<NpcTypeId> spawn_types(count);
+    std::vector<int> xs(count);
+    std::vector<int> ys(count);
+    std::vector<std::string> names(count);
+
+    pool().parallelFor(0, count, kSpawnGrain, [&](size_t from, size_t to) {
+        char digits[24];
+        for (size_t i = from; i < to; ++i) {
+            rng::CounterRng gen(seed_, rng::Stream::Spawn, 0, first + i);
+            NpcTypeId type = types[gen.uniform(0, 2)];
+            int x = 0;
+            int y = 0;
+
+            switch (config.distribution) {
+                case SpawnDistribution::Uniform:
+                    x = gen.uniform(0, width_ - 1);
+                    y = gen.uniform(0, height_ - 1);
+                    break;
+                case SpawnDistribution::Clustered: {
+                    const Point& centre = centres[gen.uniform(0, config.clusters - 1)];
+                    x = static_cast<int>(centre.x) + gen.uniform(-half, half);
+                    y = static_cast<int>(centre.y) + gen.uniform(-half, half);
+                    break;
+                }
+                case SpawnDistribution::Gaussian: {
+                    // Преобразование Бокса - Мюллера; 1 - unit() не бывает нулём
+                    const Point& centre = centres[gen.uniform(0, config.clusters - 1)];
+                    double radius = spread * std::sqrt(-2.0 * std::log(1.0 - gen.unit()));
+                    double angle = 2.0 * 3.14159265358979323846 * gen.unit();
+                    x = static_cast<int>(std::lround(centre.x + radius * std::cos(angle)));
+                    y = static_cast<int>(std::lround(centre.y + radius * std::sin(angle)));
+                    break;
+                }
+            }
 
-    std::uniform_int_distribution<> type_dist(0, types.size() - 1);
+            spawn_types[i] = type;
+            xs[i] = std::clamp(x, 0, width_ - 1);
+            ys[i] = std::clamp(y, 0, height_ - 1);
 
-    for (int i = 0; i < count; ++i) {
-        std::string type = types[type_dist(gen)];
-        std::string name = type + "_" + std::to_string(i);
-        int x = x_dist(gen);
-        int y = y_dist(gen);
+            std::string_view type_name = npcTypeName(type);
+            auto end = std::to_chars(digits, digits + sizeof(digits), i).ptr;
+            std::string& name = names[i];
+            name.reserve(type_name.size() + 1 + static_cast<size_t>(end - digits));
+            name.append(type_name).append(1, '_').append(digits, end);
+        }
+    });
+
+    WorldStore::Index first_index = static_cast<WorldStore::Index>(first);
+    world_.reserve(world_.size() + count);
+    npc_objects_.reserve(world_.size() + count);
+
+    // Имена внутри вызова различны, совпасть они могут только с прежними NPC
+    std::vector<WorldStore::Index> existing;
+    if (first_index != 0) {
+        existing.assign(count, WorldStore::kNotFound);
+        pool().parallelFor(0, count, kSpawnGrain, [&](size_t from, size_t to) {
+            for (size_t i = from; i < to; ++i) {
+                existing[i] = world_.find(names[i]);
+            }
+        });
+    }
+    bool replaces = std::any_of(existing.begin(), existing.end(),
+                                [](WorldStore::Index i) { return i != WorldStore::kNotFound; });
 
-        try {
-            auto npc = NpcFactory::createNpc(type, name, x, y);
-            addNpc(std::move(npc));
-        } catch (const std::exception& e) {
-            std::cerr << "Error creating NPC: " << e.what() << std::endl;
+    if (!replaces) {
+        world_.append(names, spawn_types, xs, ys, pool(), kSpawnGrain);
+        npc_objects_.resize(world_.size());
+        for (size_t i = 0; i < count; ++i) {
+            grid_.insert(first_index + static_cast<WorldStore::Index>(i), xs[i], ys[i]);
+        }
+    } else {
+        // Редкий случай замены - по одному NPC, как в addNpc
+        for (size_t i = 0; i < count; ++i) {
+            WorldStore::Index index = existing[i];
+            if (index != WorldStore::kNotFound && world_.isAlive(index)) {
+                grid_.remove(index, world_.getX(index), world_.getY(index));
+            }
+
+            index = world_.add(names[i], spawn_types[i], xs[i], ys[i], true);
+            if (index == npc_objects_.size()) {
+                npc_objects_.emplace_back();
+            } else {
+                npc_objects_[index].reset();
+            }
+            grid_.insert(index, xs[i], ys[i]);
         }
     }
+
+    world_version_.fetch_add(1, std::memory_order_release);
 }
 
-void GameEngine::movementThreadFunc() {
-    while (running_) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+void GameEngine::step() {
+    if (execution_mode_ == ExecutionMode::Coroutines) {
+        stepCoroutines();
+    } else {
         processMovement();
-        detectAndQueueCombats();
+        queueCombats(detectCombats());
+        processCombats();
     }
+    tick_.fetch_add(1, std::memory_order_release);
+
+    std::shared_lock<std::shared_mutex> lock(npcs_mutex_);
+    publishSnapshot();
 }
 
-void GameEngine::processMovement() {
-    std::vector<std::string> npc_names;
-    
-    {
-        std::shared_lock<std::shared_mutex> lock(npcs_mutex_);
-        for (const auto& [name, npc] : npcs_) {
-            if (npc && npc->isAlive()) {
-                npc_names.push_back(name);
+void GameEngine::publishSnapshot() const {
+    std::lock_guard<std::mutex> snapshot_lock(snapshot_mutex_);
+
+    // Буфер без читателей берём повторно: assign не выделяет память,
+    // если размер мира не вырос
+    std::shared_ptr<WorldSnapshot> next;
+    if (spare_ && spare_.use_count() == 1) {
+        // Синхронизация с освобождением снимка последним читателем
+        std::atomic_thread_fence(std::memory_order_acquire);
+        next = std::move(spare_);
+    } else {
+        next = std::make_shared<WorldSnapshot>();
+    }
+
+    std::uint64_t version = world_version_.load(std::memory_order_acquire);
+    next->tick = tick_.load(std::memory_order_acquire);
+    next->version = version;
+    next->width = width_;
+    next->height = height_;
+    next->xs.assign(world_.getXs().begin(), world_.getXs().end());
+    next->ys.assign(world_.getYs().begin(), world_.getYs().end());
+    next->types.assign(world_.getTypeIds().begin(), world_.getTypeIds().end());
+    next->alive.assign(world_.getAlive().begin(), world_.getAlive().end());
+    next->names = currentNames();
+
+    snapshot_.store(next, std::memory_order_release);
+    spare_ = std::move(published_);
+    published_ = std::move(next);
+}
+
+const std::shared_ptr<const std::vector<std::string>>& GameEngine::currentNames() const {
+    // Имена копируются, только когда сменился состав NPC
+    std::uint64_t version = world_version_.load(std::memory_order_acquire);
+    if (!snapshot_names_ || snapshot_names_version_ != version) {
+        snapshot_names_ = std::make_shared<const std::vector<std::string>>(world_.copyNames());
+        snapshot_names_version_ = version;
+    }
+    return snapshot_names_;
+}
+
+std::shared_ptr<const WorldSnapshot> GameEngine::getSnapshot() const {
+    std::shared_ptr<const WorldSnapshot> snapshot = snapshot_.load(std::memory_order_acquire);
+    if (snapshot && snapshot->version == world_version_.load(std::memory_order_acquire)) {
+        return snapshot;
+    }
+
+    // Состав NPC изменился после последней публикации. Эксклюзивная
+    // блокировка дожидается конца текущей фазы, чтобы не читать флаги
+    // жизни во время боёв
+    std::unique_lock<std::shared_mutex> lock(npcs_mutex_);
+    publishSnapshot();
+    return snapshot_.load(std::memory_order_acquire);
+}
+
+std::uint64_t GameEngine::getTick() const {
+    return tick_.load(std::memory_order_acquire);
+}
+
+void GameEngine::setTickConfig(const TickConfig& config) {
+    if (config.realtime && config.ticks_per_second <= 0.0) {
+        throw std::invalid_argument("Tick rate must be positive in realtime mode.");
+    }
+    tick_config_ = config;
+}
+
+GameEngine::TickConfig GameEngine::getTickConfig() const {
+    return tick_config_;
+}
+
+GameEngine::RunStats GameEngine::runTicks(std::uint64_t ticks) {
+    using Clock = std::chrono::steady_clock;
+    const TickConfig config = tick_config_;
+
+    // Расписание абсолютное: шаг k должен начаться в start + k * period,
+    // поэтому задержка одного шага не сдвигает остальные
+    Clock::duration period = Clock::duration::zero();
+    if (config.realtime) {
+        period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / config.ticks_per_second));
+    }
+
+    const CheckpointConfig checkpoints = getCheckpointConfig();
+
+    RunStats stats{};
+    auto start = Clock::now();
+    for (std::uint64_t k = 0; k < ticks; ++k) {
+        if (config.realtime) {
+            auto due = start + period * static_cast<Clock::rep>(k + 1);
+            if (Clock::now() > due) {
+                ++stats.late_ticks;
+            } else {
+                std::this_thread::sleep_until(due);
             }
         }
+
+        step();
+
+        if (checkpoints.every_ticks != 0 && getTick() % checkpoints.every_ticks == 0) {
+            bool delta = false;
+            if (checkpoints.delta) {
+                std::lock_guard<std::mutex> lock(checkpoint_mutex_);
+                delta = checkpoint_chain_.size() < checkpoints.full_every;
+            }
+            checkpoint(checkpoints.prefix + "-" + std::to_string(getTick()) + ".ckpt", delta);
+        }
+
+        if (config.display_every != 0 && getTick() % config.display_every == 0) {
+            printMap();
+        }
     }
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dir_dist(0, 3); // 4 направления
+    stats.ticks = ticks;
+    stats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    stats.ticks_per_second = stats.seconds > 0.0 ? ticks / stats.seconds : 0.0;
 
-    for (const auto& name : npc_names) {
-        std::unique_lock<std::shared_mutex> lock(npcs_mutex_);
-        auto it = npcs_.find(name);
-        if (it != npcs_.end() && it->second) {
-            processMovement(it->second.get());
+    // К возврату все сообщения боёв прогона уже выведены
+    flushEvents();
+    return stats;
+}
+
+void GameEngine::stepCoroutines() {
+    if (scheduler_.size() == 0 || scheduled_npcs_ != world_.size()) {
+        spawnRoutines();
+    }
+    scheduler_.runTick();
+}
+
+void GameEngine::spawnRoutines() {
+    scheduler_.clear();
+    removeDeadFromGrid();
+
+    // Порядок возобновления постоянный: сначала пачки движения, затем бои
+    WorldStore::Index count = static_cast<WorldStore::Index>(world_.size());
+    for (WorldStore::Index from = 0; from < count; from += kCoroutineBatch) {
+        WorldStore::Index to = std::min<WorldStore::Index>(count, from + kCoroutineBatch);
+        scheduler_.spawn(movementRoutine(from, to));
+    }
+    scheduler_.spawn(combatRoutine());
+    scheduled_npcs_ = world_.size();
+}
+
+TickTask GameEngine::movementRoutine(WorldStore::Index from, WorldStore::Index to) {
+    // Один поток: сетка обновляется сразу после перемещения
+    for (;;) {
+        for (WorldStore::Index i = from; i < to; ++i) {
+            if (!world_.isAlive(i)) continue;
+
+            int old_x = world_.getX(i);
+            int old_y = world_.getY(i);
+            processMovement(i);
+            grid_.update(i, old_x, old_y, world_.getX(i), world_.getY(i));
         }
+        co_await scheduler_.nextTick();
     }
 }
 
-void GameEngine::processMovement(Npc* npc) {
-    if (!npc || !npc->isAlive()) return;
+TickTask GameEngine::combatRoutine() {
+    // Пары не проходят через очередь: найдены - сразу сражаются
+    std::vector<KillEvent> kills;
+    std::vector<FightOutcome> outcomes;
+    for (;;) {
+        std::vector<CombatPair> pairs = collectCombatPairs();
+        outcomes.resize(pairs.size());
+        for (size_t k = 0; k < pairs.size(); ++k) {
+            outcomes[k] = fight(pairs[k].first, pairs[k].second);
+        }
+        appendKills(pairs, outcomes, kills);
+        if (!kills.empty()) shareEventNames();
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dir_dist(0, 3); // 4 направления
-    std::uniform_int_distribution<> dist_dist(1, getStats(npc->getType()).movement_distance);
+        std::uint64_t tick = tick_.load(std::memory_order_relaxed);
+        for (const auto& kill : kills) {
+            const CombatPair& pair = pairs[kill.task];
+            WorldStore::Index killer = kill.by_first ? pair.first : pair.second;
+            grid_.remove(kill.victim, world_.getX(kill.victim), world_.getY(kill.victim));
+            events_->push({tick, killer, kill.victim, events_source_, EventKind::Kill});
+        }
+        kills.clear();
 
-    int direction = dir_dist(gen);
-    int distance = dist_dist(gen);
+        co_await scheduler_.nextTick();
+    }
+}
 
-    int new_x = npc->getX();
-    int new_y = npc->getY();
+void GameEngine::processMovement() {
+    std::unique_lock<std::shared_mutex> lock(npcs_mutex_);
+    removeDeadFromGrid();
+
+    // Куски NPC двигаются параллельно: каждый пишет только свои слоты,
+    // прежние позиции запоминаются там же, без отдельного прохода
+    old_xs_.resize(world_.size());
+    old_ys_.resize(world_.size());
+    pool().parallelFor(0, world_.size(), kMovementGrain, [this](size_t from, size_t to) {
+        for (size_t i = from; i < to; ++i) {
+            WorldStore::Index npc = static_cast<WorldStore::Index>(i);
+            old_xs_[i] = world_.getX(npc);
+            old_ys_[i] = world_.getY(npc);
+            processMovement(npc);
+        }
+    });
+
+    // Сетка общая, её обновляем последовательно (меняются только
+    // NPC, сменившие ячейку)
+    for (WorldStore::Index i = 0; i < world_.size(); ++i) {
+        if (world_.isAlive(i)) {
+            grid_.update(i, old_xs_[i], old_ys_[i], world_.getX(i), world_.getY(i));
+        }
+    }
+}
+
+void GameEngine::processMovement(WorldStore::Index npc) {
+    if (!world_.isAlive(npc)) return;
+
+    int movement_distance = rules_.getStats(world_.getTypeId(npc)).movement_distance;
+    if (movement_distance < 1) return;  // Тип без скорости стоит на месте
+
+    rng::CounterRng gen(seed_, rng::Stream::Movement, tick_.load(std::memory_order_relaxed), npc);
+    int direction = gen.uniform(0, 3); // 4 направления
+    int distance = gen.uniform(1, movement_distance);
+
+    int new_x = world_.getX(npc);
+    int new_y = world_.getY(npc);
 
     switch (direction) {
         case 0: new_x = std::min(width_ - 1, new_x + distance); break; // Right
@@ -109,183 +539,389 @@ void GameEngine::processMovement(Npc* npc) {
         case 3: new_y = std::max(0, new_y - distance); break; // Up
     }
 
-    npc->setX(new_x);
-    npc->setY(new_y);
+    world_.setPosition(npc, new_x, new_y);
 }
 
-void GameEngine::detectAndQueueCombats() {
-    std::vector<std::string> names;
-    
+bool GameEngine::isCombatPair(WorldStore::Index npc1, WorldStore::Index npc2) const {
+    if (!world_.isAlive(npc1) || !world_.isAlive(npc2)) return false;
+
+    int dx = world_.getX(npc1) - world_.getX(npc2);
+    int dy = world_.getY(npc1) - world_.getY(npc2);
+    double distance = std::sqrt(dx * dx + dy * dy);
+    NpcTypeId type1 = world_.getTypeId(npc1);
+    NpcTypeId type2 = world_.getTypeId(npc2);
+    int kill_dist_1 = rules_.getStats(type1).kill_distance;
+    int kill_dist_2 = rules_.getStats(type2).kill_distance;
+
+    if (distance > std::max(kill_dist_1, kill_dist_2)) return false;
+
+    return rules_.canKill(type1, type2) || rules_.canKill(type2, type1);
+}
+
+GameEngine::CombatPair GameEngine::makePair(WorldStore::Index npc1, WorldStore::Index npc2) const {
+    // Порядок в паре как при переборе: по возрастанию имени
+    if (world_.getName(npc1) < world_.getName(npc2)) {
+        return {npc1, npc2};
+    }
+    return {npc2, npc1};
+}
+
+MovementTask GameEngine::makeTask(const CombatPair& pair) const {
+    return {pair.first, pair.second};
+}
+
+std::uint64_t GameEngine::pairKey(WorldStore::Index npc1, WorldStore::Index npc2) {
+    if (npc1 > npc2) std::swap(npc1, npc2);
+    return (static_cast<std::uint64_t>(npc1) << 32) | npc2;
+}
+
+std::vector<GameEngine::CombatPair> GameEngine::detectCombats() {
+    std::vector<CombatPair> pairs;
     {
         std::shared_lock<std::shared_mutex> lock(npcs_mutex_);
-        for (const auto& [name, npc] : npcs_) {
-            if (npc && npc->isAlive()) {
-                names.push_back(name);
-            }
+        pairs = collectCombatPairs();
+    }
+
+    // Пары отсортированы по ключу, поэтому повторы стоят рядом
+    auto last = std::unique(pairs.begin(), pairs.end(), [](const CombatPair& a, const CombatPair& b) {
+        return pairKey(a.first, a.second) == pairKey(b.first, b.second);
+    });
+    duplicates_dropped_.fetch_add(static_cast<std::uint64_t>(pairs.end() - last), std::memory_order_relaxed);
+    pairs.erase(last, pairs.end());
+    return pairs;
+}
+
+void GameEngine::queueCombats(const std::vector<CombatPair>& pairs) {
+    // Обратное давление, как в detectAndQueueCombats
+    for (const auto& pair : pairs) {
+        while (!combat_queue_.tryPush(makeTask(pair))) {
+            processCombats();
+        }
+    }
+}
+
+void GameEngine::detectAndQueueCombats() {
+    std::vector<CombatPair> pairs = detectCombats();
+    if (pairs.empty()) return;
+
+    std::unique_lock<std::mutex> pending_lock(pending_mutex_);
+    for (const auto& pair : pairs) {
+        // Пара уже ждёт в очереди - второй раз не ставим
+        std::uint64_t key = pairKey(pair.first, pair.second);
+        if (!pending_pairs_.insert(key).second) {
+            duplicates_dropped_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        // Обратное давление: очередь полна - её бои проводятся сейчас, и
+        // пара ставится снова. Пары идут по возрастанию ключа, а processCombats
+        // разбирает очередь целиком, поэтому бои идут в том же порядке, что и
+        // за один проход (как в режиме корутин)
+        while (!combat_queue_.tryPush(makeTask(pair))) {
+            pending_lock.unlock();
+            processCombats();
+            pending_lock.lock();
         }
     }
+}
+
+std::vector<MovementTask> GameEngine::findCombatPairs() const {
+    std::shared_lock<std::shared_mutex> lock(npcs_mutex_);
+
+    std::vector<MovementTask> tasks;
+    for (const auto& pair : collectCombatPairs()) {
+        tasks.push_back(makeTask(pair));
+    }
+    return tasks;
+}
+
+std::vector<GameEngine::CombatPair> GameEngine::collectCombatPairs() const {
+    if (detection_mode_ == DetectionMode::BruteForce) {
+        return findCombatPairsBruteForce();
+    }
+    return findCombatPairsGrid();
+}
 
-    CombatVisitor visitor;
+std::vector<GameEngine::CombatPair> GameEngine::findCombatPairsGrid() const {
+    std::vector<CombatPair> pairs;
+    int rows = grid_.getRows();
+    if (execution_mode_ == ExecutionMode::Coroutines) {
+        scanGridRows(0, rows, pairs);
+        sortPairs(pairs);
+        return pairs;
+    }
 
-    for (size_t i = 0; i < names.size(); ++i) {
-        for (size_t j = i + 1; j < names.size(); ++j) {
-            std::shared_lock<std::shared_mutex> lock(npcs_mutex_);
-            auto npc1_it = npcs_.find(names[i]);
-            auto npc2_it = npcs_.find(names[j]);
+    // Строки сетки делятся на куски; результаты кусков склеиваются
+    // по порядку, поэтому список пар не зависит от числа потоков
+    std::vector<std::vector<CombatPair>> chunk_pairs(rows);
+    pool().parallelFor(0, rows, kDetectionGrain, [&](size_t from, size_t to) {
+        scanGridRows(static_cast<int>(from), static_cast<int>(to), chunk_pairs[from]);
+    });
 
-            if (npc1_it != npcs_.end() && npc2_it != npcs_.end() &&
-                npc1_it->second && npc2_it->second &&
-                npc1_it->second->isAlive() && npc2_it->second->isAlive()) {
+    for (const auto& chunk : chunk_pairs) {
+        pairs.insert(pairs.end(), chunk.begin(), chunk.end());
+    }
+    sortPairs(pairs);
+    return pairs;
+}
 
-                double distance = npc1_it->second->distanceTo(*npc2_it->second);
-                int kill_dist_1 = getStats(npc1_it->second->getType()).kill_distance;
-                int kill_dist_2 = getStats(npc2_it->second->getType()).kill_distance;
+void GameEngine::scanGridRows(int from, int to, std::vector<CombatPair>& pairs) const {
+    // Столбцы окрестности ячейки, собранные из world_ для пакетной проверки
+    std::vector<int> xs;
+    std::vector<int> ys;
+    std::vector<NpcTypeId> types;
+    std::vector<std::uint8_t> alive;
+    std::vector<std::uint32_t> hits;
 
-                if (distance <= std::max(kill_dist_1, kill_dist_2)) {
-                    if (visitor.canKill(npc1_it->second.get(), npc2_it->second.get()) ||
-                        visitor.canKill(npc2_it->second.get(), npc1_it->second.get())) {
-                        std::lock_guard<std::mutex> task_lock(movement_queue_mutex_);
-                        movement_tasks_.push({names[i], names[j]});
-                    }
-                }
+    grid_.forEachNeighbourhood(from, to, [&](const std::vector<WorldStore::Index>& block, size_t cell_count) {
+        xs.clear();
+        ys.clear();
+        types.clear();
+        alive.clear();
+        for (WorldStore::Index i : block) {
+            xs.push_back(world_.getX(i));
+            ys.push_back(world_.getY(i));
+            types.push_back(world_.getTypeId(i));
+            alive.push_back(world_.isAlive(i) ? 1 : 0);
+        }
+        hits.resize(block.size());
+
+        for (size_t i = 0; i < cell_count; ++i) {
+            if (!alive[i]) continue;
+
+            // Партнёры block[i] - все элементы после него
+            size_t rest = i + 1;
+            combat_kernel::Probe probe{xs[i], ys[i], types[i]};
+            combat_kernel::Block partners{xs.data() + rest, ys.data() + rest, types.data() + rest,
+                                          alive.data() + rest, block.size() - rest};
+
+            size_t found = combat_kernel::findHits(probe, partners, kernel_tables_, hits.data());
+            for (size_t k = 0; k < found; ++k) {
+                pairs.push_back(makePair(block[i], block[rest + hits[k]]));
+            }
+        }
+    });
+}
+
+void GameEngine::sortPairs(std::vector<CombatPair>& pairs) {
+    // Порядок клеток сетки зависит от истории перемещений; порядок боёв -
+    // по индексам, как при переборе, чтобы не зависеть от неё (и чтобы
+    // продолжение с контрольной точки совпадало с непрерывным прогоном)
+    std::sort(pairs.begin(), pairs.end(), [](const CombatPair& a, const CombatPair& b) {
+        return pairKey(a.first, a.second) < pairKey(b.first, b.second);
+    });
+}
+
+std::vector<GameEngine::CombatPair> GameEngine::findCombatPairsBruteForce() const {
+    std::vector<CombatPair> pairs;
+    WorldStore::Index count = static_cast<WorldStore::Index>(world_.size());
+    for (WorldStore::Index i = 0; i < count; ++i) {
+        for (WorldStore::Index j = i + 1; j < count; ++j) {
+            if (isCombatPair(i, j)) {
+                pairs.push_back(makePair(i, j));
             }
         }
     }
+
+    return pairs;
 }
 
-void GameEngine::combatThreadFunc() {
-    CombatVisitor visitor;
+void GameEngine::processCombats() {
+    // Очередь разбирается целиком в порядке постановки
+    std::vector<MovementTask> tasks;
+    while (combat_queue_.tryPopBatch(tasks, kCombatBatchSize) > 0) {
+    }
+    if (tasks.empty()) return;
+
+    std::vector<CombatPair> pairs;
+    pairs.reserve(tasks.size());
+    for (const auto& task : tasks) {
+        pairs.push_back({task.npc1, task.npc2});
+    }
+    // Порядок боёв - по индексам пар, как в режиме корутин
+    sortPairs(pairs);
 
-    while (running_) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::vector<FightOutcome> outcomes(pairs.size());
+    std::vector<KillEvent> kills;
+    {
+        std::shared_lock<std::shared_mutex> lock(npcs_mutex_);
 
-        MovementTask task;
+        // Задачи извлечены из очереди: пары снова можно ставить в бой.
+        // Шаг множество не заполняет, и тогда перебирать пары не нужно
         {
-            std::lock_guard<std::mutex> lock(movement_queue_mutex_);
-            if (movement_tasks_.empty()) continue;
-            task = movement_tasks_.front();
-            movement_tasks_.pop();
+            std::lock_guard<std::mutex> pending_lock(pending_mutex_);
+            if (!pending_pairs_.empty()) {
+                for (const auto& pair : pairs) {
+                    pending_pairs_.erase(pairKey(pair.first, pair.second));
+                }
+            }
+        }
+
+        // Пачки идут по порядку, бои внутри пачки - параллельно: их
+        // участники не пересекаются, поэтому исход не зависит от числа потоков
+        std::vector<size_t> order;
+        std::vector<size_t> bounds = colourPairs(pairs, order);
+        for (size_t b = 0; b + 1 < bounds.size(); ++b) {
+            pool().parallelFor(bounds[b], bounds[b + 1], kCombatGrain, [&](size_t from, size_t to) {
+                for (size_t k = from; k < to; ++k) {
+                    size_t i = order[k];
+                    outcomes[i] = fight(pairs[i].first, pairs[i].second);
+                }
+            });
         }
 
-        processCombat(task);
+        appendKills(pairs, outcomes, kills);
+        if (!kills.empty()) shareEventNames();
     }
-}
 
-void GameEngine::processCombat(const MovementTask& task) {
-    std::unique_lock<std::shared_mutex> lock(npcs_mutex_);
+    // Сетку меняет только фаза движения под эксклюзивной блокировкой
+    {
+        std::lock_guard<std::mutex> dead_lock(dead_mutex_);
+        for (const auto& kill : kills) {
+            dead_pending_.push_back(kill.victim);
+        }
+    }
 
-    auto npc1_it = npcs_.find(task.npc1_name);
-    auto npc2_it = npcs_.find(task.npc2_name);
+    // Сообщения - записи в буфер журнала, имена подставит его поток
+    std::uint64_t tick = tick_.load(std::memory_order_relaxed);
+    for (const auto& kill : kills) {
+        const CombatPair& pair = pairs[kill.task];
+        WorldStore::Index killer = kill.by_first ? pair.first : pair.second;
+        events_->push({tick, killer, kill.victim, events_source_, EventKind::Kill});
+    }
+}
 
-    if (npc1_it == npcs_.end() || npc2_it == npcs_.end()) return;
-    if (!npc1_it->second || !npc2_it->second) return;
-    if (!npc1_it->second->isAlive() || !npc2_it->second->isAlive()) return;
+GameEngine::CombatStats GameEngine::getCombatStats() const {
+    CombatStats stats{};
+    stats.queue = combat_queue_.getStats();
+    stats.duplicates_dropped = duplicates_dropped_.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> pending_lock(pending_mutex_);
+        stats.pending_pairs = pending_pairs_.size();
+    }
+    return stats;
+}
 
-    CombatVisitor visitor;
+GameEngine::FightOutcome GameEngine::fight(WorldStore::Index npc1, WorldStore::Index npc2) {
+    FightOutcome outcome;
+    if (!world_.isAlive(npc1) || !world_.isAlive(npc2)) return outcome;
 
-    bool npc1_attacks = visitor.canKill(npc1_it->second.get(), npc2_it->second.get());
-    bool npc2_attacks = visitor.canKill(npc2_it->second.get(), npc1_it->second.get());
+    bool npc1_attacks = rules_.canKill(world_.getTypeId(npc1), world_.getTypeId(npc2));
+    bool npc2_attacks = rules_.canKill(world_.getTypeId(npc2), world_.getTypeId(npc1));
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dice(1, 6);
+    rng::CounterRng dice(seed_, rng::Stream::Combat, tick_.load(std::memory_order_relaxed),
+                         pairKey(npc1, npc2));
 
     if (npc1_attacks) {
-        int npc1_attack = dice(gen);
-        int npc2_defense = dice(gen);
-
-        if (npc1_attack > npc2_defense) {
-            npc2_it->second->kill();
-            {
-                std::lock_guard<std::mutex> cout_lock(cout_mutex_);
-                std::cout << "[COMBAT] " << npc1_it->second->getName()
-                         << " killed " << npc2_it->second->getName() << std::endl;
-            }
+        int npc1_attack = dice.uniform(1, 6);
+        int npc2_defense = dice.uniform(1, 6);
+
+        if (npc1_attack > npc2_defense && world_.kill(npc2)) {
+            outcome.first_killed = true;
         }
     }
 
-    if (npc2_attacks && npc1_it->second->isAlive()) {
-        int npc2_attack = dice(gen);
-        int npc1_defense = dice(gen);
+    if (npc2_attacks && world_.isAlive(npc1)) {
+        int npc2_attack = dice.uniform(1, 6);
+        int npc1_defense = dice.uniform(1, 6);
 
-        if (npc2_attack > npc1_defense) {
-            npc1_it->second->kill();
-            {
-                std::lock_guard<std::mutex> cout_lock(cout_mutex_);
-                std::cout << "[COMBAT] " << npc2_it->second->getName()
-                         << " killed " << npc1_it->second->getName() << std::endl;
-            }
+        if (npc2_attack > npc1_defense && world_.kill(npc1)) {
+            outcome.second_killed = true;
         }
     }
+    return outcome;
 }
 
-void GameEngine::displayThreadFunc() {
-    while (running_) {
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-        printMap();
+void GameEngine::appendKills(const std::vector<CombatPair>& pairs,
+                             const std::vector<FightOutcome>& outcomes,
+                             std::vector<KillEvent>& kills) {
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        if (outcomes[i].first_killed) kills.push_back({i, true, pairs[i].second});
+        if (outcomes[i].second_killed) kills.push_back({i, false, pairs[i].first});
     }
 }
 
+std::vector<size_t> GameEngine::colourPairs(const std::vector<CombatPair>& pairs,
+                                            std::vector<size_t>& order) {
+    combat_batch_.resize(world_.size(), 0);
+
+    // Жадная раскладка: пачка пары - на одну больше последней пачки её участников
+    std::vector<std::uint32_t> batch_of(pairs.size());
+    std::uint32_t batches = 0;
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        std::uint32_t batch = std::max(combat_batch_[pairs[i].first], combat_batch_[pairs[i].second]) + 1;
+        combat_batch_[pairs[i].first] = batch;
+        combat_batch_[pairs[i].second] = batch;
+        batch_of[i] = batch;
+        batches = std::max(batches, batch);
+    }
+    for (const auto& pair : pairs) {
+        combat_batch_[pair.first] = 0;
+        combat_batch_[pair.second] = 0;
+    }
+
+    // Сортировка подсчётом по номеру пачки, внутри пачки - порядок пар
+    std::vector<size_t> bounds(batches + 1, 0);
+    for (std::uint32_t batch : batch_of) {
+        ++bounds[batch];
+    }
+    for (size_t b = 1; b <= batches; ++b) {
+        bounds[b] += bounds[b - 1];
+    }
+    order.resize(pairs.size());
+    std::vector<size_t> next(bounds.begin(), bounds.end() - 1);
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        order[next[batch_of[i] - 1]++] = i;
+    }
+    return bounds;
+}
+
+void GameEngine::removeDeadFromGrid() {
+    std::lock_guard<std::mutex> dead_lock(dead_mutex_);
+    for (WorldStore::Index npc : dead_pending_) {
+        // Живой - слот уже занят новым NPC, его ячейка в сетке верна
+        if (world_.isAlive(npc)) continue;
+        grid_.remove(npc, world_.getX(npc), world_.getY(npc));
+    }
+    dead_pending_.clear();
+}
+
 void GameEngine::printMap() const {
-    std::lock_guard<std::mutex> cout_lock(const_cast<std::mutex&>(cout_mutex_));
-    std::shared_lock<std::shared_mutex> data_lock(npcs_mutex_);
-
-    // Создаём двумерный массив для карты
-    std::vector<std::vector<char>> map(height_, std::vector<char>(width_, '.'));
-    
-    int alive_count = 0;
-    std::vector<std::pair<std::string, std::pair<int, int>>> npcs_list;
-    
-    // Заполняем карту и считаем живых
-    for (const auto& [name, npc] : npcs_) {
-        if (npc && npc->isAlive()) {
-            alive_count++;
-            int x = npc->getX();
-            int y = npc->getY();
-            if (x >= 0 && x < width_ && y >= 0 && y < height_) {
-                char symbol = npc->getType()[0];  // Первая буква типа
-                if (map[y][x] == '.') {
-                    map[y][x] = symbol;
-                } else {
-                    map[y][x] = '*';  // Звёздочка если несколько NPC на одной клетке
-                }
-            }
-            npcs_list.push_back({name, {x, y}});
-        }
+    // Рисуем по снимку: симуляция во время вывода не ждёт
+    std::shared_ptr<const WorldSnapshot> snapshot = getSnapshot();
+
+    // Сообщения боёв до этого шага выводятся раньше карты
+    flushEvents();
+    std::lock_guard<std::mutex> cout_lock(cout_mutex_);
+
+    // Рендерер создаётся при первом выводе: для огромных карт, которые не
+    // печатаются, буфер на width * height не выделяется
+    if (!renderer_) {
+        renderer_ = std::make_unique<MapRenderer>(width_, height_);
     }
 
-    // Выводим карту
-    std::cout << "\n+====================================================================================================+\n";
-    std::cout << "|                                    [MAP] GAME WORLD STATE                                         |\n";
-    std::cout << "+----------------------------------------------------------------------------------------------------+\n";
-    
-    // Выводим шапку с номерами колонок (каждые 10)
-    std::cout << "|   ";
-    for (int x = 0; x < width_; x += 10) {
-        std::cout << std::setw(9) << x;
-    }
-    std::cout << "|\n";
-    
-    // Выводим саму карту
-    for (int y = 0; y < height_; y++) {
-        std::cout << "| " << std::setw(2) << y << " ";
-        for (int x = 0; x < width_; x++) {
-            std::cout << map[y][x];
-        }
-        std::cout << " |\n";
-    }
-    
-    std::cout << "+----------------------------------------------------------------------------------------------------+\n";
-    std::cout << "| Legend: . = empty, * = multiple NPCs, Letter = NPC type (K=Knight, D=Druid, E=Elf, O=Orc, etc.)  |\n";
-    std::cout << "| Alive NPCs: " << alive_count << "/" << npcs_.size();
-    for (int i = alive_count; i < 12; i++) std::cout << " ";
-    std::cout << "|\n";
-    std::cout << "+====================================================================================================+\n";
+    const std::string& frame = renderer_->render(*snapshot, render_mode_);
+    std::cout.write(frame.data(), static_cast<std::streamsize>(frame.size()));
     std::cout << std::flush;  // Принудительный сброс буфера для Docker
 }
 
+void GameEngine::setRenderMode(MapRenderer::Mode mode) {
+    std::lock_guard<std::mutex> cout_lock(cout_mutex_);
+    render_mode_ = mode;
+    if (renderer_) renderer_->reset();
+}
+
+MapRenderer::Mode GameEngine::getRenderMode() const {
+    std::lock_guard<std::mutex> cout_lock(cout_mutex_);
+    return render_mode_;
+}
+
 void GameEngine::runSimulation(int durationSeconds) {
-    running_ = true;
+    {
+        // Задачи, не обработанные в прошлом запуске, больше не в очереди
+        std::lock_guard<std::mutex> pending_lock(pending_mutex_);
+        pending_pairs_.clear();
+    }
 
     {
         std::lock_guard<std::mutex> cout_lock(cout_mutex_);
@@ -294,40 +930,159 @@ void GameEngine::runSimulation(int durationSeconds) {
         std::cout << "Duration: " << durationSeconds << " seconds" << std::endl;
     }
 
-    movement_thread_ = std::thread(&GameEngine::movementThreadFunc, this);
-    combat_thread_ = std::thread(&GameEngine::combatThreadFunc, this);
-    display_thread_ = std::thread(&GameEngine::displayThreadFunc, this);
-
-    std::this_thread::sleep_for(std::chrono::seconds(durationSeconds));
-
-    running_ = false;
-
-    movement_thread_.join();
-    combat_thread_.join();
-    display_thread_.join();
+    // Шаги и вывод карты ведёт вызывающий поток, работу фаз выполняет пул
+    runTicks(static_cast<std::uint64_t>(std::max(0, durationSeconds)) * kTicksPerSecond);
 
     {
         std::lock_guard<std::mutex> cout_lock(cout_mutex_);
         std::cout << "\n=== Simulation Ended ===" << std::endl;
         std::cout << "Survivors:" << std::endl;
-        std::shared_lock<std::shared_mutex> data_lock(npcs_mutex_);
-        for (const auto& [name, npc] : npcs_) {
-            if (npc && npc->isAlive()) {
-                std::cout << "  " << *npc << std::endl;
-            }
+        std::unique_lock<std::shared_mutex> data_lock(npcs_mutex_);
+        syncNpcObjects();
+        for (WorldStore::Index i : aliveByName()) {
+            std::cout << "  " << *npc_objects_[i] << std::endl;
         }
     }
 }
 
 std::vector<std::string> GameEngine::getSurvivors() const {
-    std::vector<std::string> survivors;
-    std::shared_lock<std::shared_mutex> lock(npcs_mutex_);
-    
-    for (const auto& [name, npc] : npcs_) {
-        if (npc && npc->isAlive()) {
-            survivors.push_back(name);
+    return getSnapshot()->survivors();
+}
+
+std::vector<WorldStore::Index> GameEngine::aliveByName() const {
+    std::vector<WorldStore::Index> result;
+    for (WorldStore::Index i = 0; i < world_.size(); ++i) {
+        if (world_.isAlive(i)) {
+            result.push_back(i);
         }
     }
-    
-    return survivors;
+
+    std::sort(result.begin(), result.end(), [this](WorldStore::Index a, WorldStore::Index b) {
+        return world_.getName(a) < world_.getName(b);
+    });
+    return result;
+}
+
+void GameEngine::syncNpcObjects() {
+    for (WorldStore::Index i = 0; i < world_.size(); ++i) {
+        Npc* npc = npc_objects_[i].get();
+        if (!npc) {
+            // NPC из spawnNpcs: объект нужен только живым для вывода
+            if (!world_.isAlive(i)) continue;
+            npc_objects_[i] = NpcFactory::createNpc(world_.getTypeId(i), std::string(world_.getName(i)),
+                                                    world_.getX(i), world_.getY(i), memory_);
+            continue;
+        }
+
+        npc->setX(world_.getX(i));
+        npc->setY(world_.getY(i));
+        if (!world_.isAlive(i) && npc->isAlive()) {
+            npc->kill();
+        }
+    }
+}
+
+void GameEngine::setCheckpointConfig(const CheckpointConfig& config) {
+    std::lock_guard<std::mutex> lock(checkpoint_mutex_);
+    checkpoint_config_ = config;
+}
+
+GameEngine::CheckpointConfig GameEngine::getCheckpointConfig() const {
+    std::lock_guard<std::mutex> lock(checkpoint_mutex_);
+    return checkpoint_config_;
+}
+
+void GameEngine::checkpoint(const std::string& filename, bool delta) {
+    // Снимок неизменяем: запись идёт в фоне, пока симуляция шагает дальше
+    std::shared_ptr<const WorldSnapshot> snapshot = getSnapshot();
+
+    std::lock_guard<std::mutex> lock(checkpoint_mutex_);
+    std::shared_ptr<const WorldSnapshot> base;
+    if (delta && last_checkpoint_ && last_checkpoint_->version == snapshot->version) {
+        base = last_checkpoint_;
+        checkpoint_chain_.push_back(filename);
+    } else {
+        checkpoint_chain_ = {filename};
+    }
+    last_checkpoint_ = snapshot;
+
+    if (!checkpoint_writer_) {
+        checkpoint_writer_ = std::make_unique<checkpoint::Writer>();
+    }
+    checkpoint_writer_->submit(filename, std::move(snapshot), std::move(base), seed_);
+}
+
+void GameEngine::waitForCheckpoints() {
+    std::unique_lock<std::mutex> lock(checkpoint_mutex_);
+    checkpoint::Writer* writer = checkpoint_writer_.get();
+    lock.unlock();
+
+    if (writer) writer->wait();
+}
+
+std::vector<std::string> GameEngine::getCheckpointChain() const {
+    std::lock_guard<std::mutex> lock(checkpoint_mutex_);
+    return checkpoint_chain_;
+}
+
+void GameEngine::resumeFromCheckpoint(const std::vector<std::string>& files) {
+    // Файлы цепочки могли ещё писаться этим движком, а сообщения боёв
+    // ссылаются на индексы, которые сейчас сменятся
+    waitForCheckpoints();
+    flushEvents();
+
+    checkpoint::State state = checkpoint::load(files);
+    if (state.width != width_ || state.height != height_) {
+        throw std::invalid_argument("Checkpoint map size does not match the engine.");
+    }
+
+    // Объекты создаются до замены мира: ошибка не оставит его наполовину пустым
+    std::vector<NpcPtr> npcs;
+    npcs.reserve(state.names.size());
+    for (size_t i = 0; i < state.names.size(); ++i) {
+        auto npc = NpcFactory::createNpc(state.types[i], state.names[i], state.xs[i], state.ys[i], memory_);
+        if (!state.alive[i]) npc->kill();
+        npcs.push_back(std::move(npc));
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> lock(npcs_mutex_);
+        world_.clear();
+        grid_.clear();
+        npc_objects_.clear();
+
+        // Индексы сохраняются: от них зависят случайные числа шагов
+        for (auto& npc : npcs) {
+            WorldStore::Index i = world_.add(npc->getName(), npc->getTypeId(),
+                                             npc->getX(), npc->getY(), npc->isAlive());
+            if (world_.isAlive(i)) {
+                grid_.insert(i, world_.getX(i), world_.getY(i));
+            }
+            npc_objects_.push_back(std::move(npc));
+        }
+
+        {
+            std::lock_guard<std::mutex> dead_lock(dead_mutex_);
+            dead_pending_.clear();
+        }
+        {
+            std::lock_guard<std::mutex> pending_lock(pending_mutex_);
+            std::vector<MovementTask> stale;
+            while (combat_queue_.tryPopBatch(stale, kCombatBatchSize) > 0) {
+            }
+            pending_pairs_.clear();
+        }
+
+        scheduler_.clear();
+        scheduled_npcs_ = 0;
+        seed_ = state.seed;
+        tick_.store(state.tick, std::memory_order_release);
+        world_version_.fetch_add(1, std::memory_order_release);
+    }
+
+    // Следующая разностная точка считается от восстановленного состояния
+    std::shared_ptr<const WorldSnapshot> snapshot = getSnapshot();
+    std::lock_guard<std::mutex> lock(checkpoint_mutex_);
+    last_checkpoint_ = std::move(snapshot);
+    checkpoint_chain_ = files;
 }
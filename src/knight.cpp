@@ -5,9 +5,7 @@
 #include <ostream>
 
 Knight::Knight(int x, int y, const std::string& name)
-    : Npc(x, y, kType, name) {}
-
-const std::string Knight::kType = "Knight";
+    : Npc(x, y, NpcTypeId::Knight, name) {}
 
 void Knight::accept(Visitor& visitor) {
     visitor.visit(*this);
@@ -0,0 +1,208 @@
+#include "../include/map_renderer.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+// Рамка кадра - те же строки, что выводила прежняя printMap
+constexpr const char* kTop =
+    "\n+====================================================================================================+\n";
+constexpr const char* kTitle =
+    "|                                    [MAP] GAME WORLD STATE                                         |\n";
+constexpr const char* kSeparator =
+    "+----------------------------------------------------------------------------------------------------+\n";
+constexpr const char* kLegend =
+    "| Legend: . = empty, * = multiple NPCs, Letter = NPC type (K=Knight, D=Druid, E=Elf, O=Orc, etc.)  |\n";
+constexpr const char* kBottom =
+    "+====================================================================================================+\n";
+
+void appendNumber(std::string& out, long long value) {
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+// Число, выровненное вправо по ширине width (как std::setw)
+void appendPadded(std::string& out, long long value, int width) {
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    int length = static_cast<int>(result.ptr - buffer);
+    if (length < width) out.append(static_cast<size_t>(width - length), ' ');
+    out.append(buffer, result.ptr);
+}
+
+int countLines(const std::string& text, size_t end) {
+    return static_cast<int>(std::count(text.begin(), text.begin() + static_cast<std::ptrdiff_t>(end), '\n'));
+}
+
+}
+
+MapRenderer::MapRenderer(int width, int height)
+    : width_(width), height_(height), has_previous_(false) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("Invalid map dimensions.");
+    }
+
+    frame_.reserve(static_cast<size_t>(width + 16) * (height + 8) + 1024);
+    frame_ += kTop;
+    frame_ += kTitle;
+    frame_ += kSeparator;
+
+    // Шапка с номерами колонок (каждые 10)
+    frame_ += "|   ";
+    for (int x = 0; x < width_; x += 10) {
+        appendPadded(frame_, x, 9);
+    }
+    frame_ += "|\n";
+
+    // Строки карты: номер не уже двух символов
+    int label_width = 2;
+    for (int rows = height_ - 1; rows >= 100; rows /= 10) ++label_width;
+
+    row_offsets_.resize(static_cast<size_t>(height_));
+    for (int y = 0; y < height_; ++y) {
+        frame_ += "| ";
+        appendPadded(frame_, y, label_width);
+        frame_ += ' ';
+        row_offsets_[static_cast<size_t>(y)] = frame_.size();
+        frame_.append(static_cast<size_t>(width_), '.');
+        frame_ += " |\n";
+    }
+
+    frame_ += kSeparator;
+    frame_ += kLegend;
+    static_size_ = frame_.size();
+
+    first_row_line_ = countLines(frame_, row_offsets_[0]) + 1;
+    cell_column_ = 2 + label_width + 1 + 1;
+    counter_line_ = countLines(frame_, static_size_) + 1;
+    total_lines_ = counter_line_ + 1;
+
+    previous_.assign(static_cast<size_t>(width_) * height_, '.');
+}
+
+int MapRenderer::getWidth() const {
+    return width_;
+}
+
+int MapRenderer::getHeight() const {
+    return height_;
+}
+
+void MapRenderer::reset() {
+    has_previous_ = false;
+}
+
+void MapRenderer::fill(const WorldSnapshot& snapshot) {
+    for (size_t offset : row_offsets_) {
+        std::fill_n(frame_.begin() + static_cast<std::ptrdiff_t>(offset), width_, '.');
+    }
+
+    // Первая буква каждого типа
+    char symbols[kNpcTypeCount];
+    for (size_t i = 0; i < kNpcTypeCount; ++i) {
+        symbols[i] = npcTypeName(static_cast<NpcTypeId>(i))[0];
+    }
+
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        if (!snapshot.isAlive(i)) continue;
+
+        int x = snapshot.xs[i];
+        int y = snapshot.ys[i];
+        if (x < 0 || x >= width_ || y < 0 || y >= height_) continue;
+
+        char& cell = frame_[row_offsets_[static_cast<size_t>(y)] + static_cast<size_t>(x)];
+        if (cell == '.') {
+            size_t type = toIndex(snapshot.types[i]);
+            cell = type < kNpcTypeCount ? symbols[type] : '?';
+        } else {
+            cell = '*';  // Звёздочка если несколько NPC на одной клетке
+        }
+    }
+}
+
+void MapRenderer::appendCounter(const WorldSnapshot& snapshot, std::string& out) const {
+    size_t alive = snapshot.aliveCount();
+    out += "| Alive NPCs: ";
+    appendNumber(out, static_cast<long long>(alive));
+    out += '/';
+    appendNumber(out, static_cast<long long>(snapshot.size()));
+    if (alive < 12) out.append(12 - alive, ' ');
+    out += "|";
+}
+
+const std::string& MapRenderer::render(const WorldSnapshot& snapshot, Mode mode) {
+    fill(snapshot);
+
+    // Хвост кадра: счётчик живых и нижняя рамка (длина зависит от чисел)
+    frame_.resize(static_size_);
+    appendCounter(snapshot, frame_);
+    std::string counter = frame_.substr(static_size_);
+    frame_ += "\n";
+    frame_ += kBottom;
+
+    if (mode == Mode::Full) {
+        has_previous_ = false;
+        return frame_;
+    }
+
+    renderDiff(counter);
+    return diff_;
+}
+
+void MapRenderer::appendCursor(int line, int column) {
+    diff_ += "\x1b[";
+    appendNumber(diff_, line);
+    diff_ += ';';
+    appendNumber(diff_, column);
+    diff_ += 'H';
+}
+
+void MapRenderer::renderDiff(const std::string& counter) {
+    diff_.clear();
+
+    if (!has_previous_) {
+        // Полная перерисовка: курсор в начало, очистка экрана
+        diff_ += "\x1b[H\x1b[2J";
+        diff_ += frame_;
+    } else {
+        for (int y = 0; y < height_; ++y) {
+            const char* current = frame_.data() + row_offsets_[static_cast<size_t>(y)];
+            const char* previous = previous_.data() + static_cast<size_t>(y) * width_;
+            if (std::memcmp(current, previous, static_cast<size_t>(width_)) == 0) continue;
+
+            // Подряд идущие изменённые клетки - одно перемещение курсора
+            int x = 0;
+            while (x < width_) {
+                if (current[x] == previous[x]) {
+                    ++x;
+                    continue;
+                }
+                int run = x;
+                while (run < width_ && current[run] != previous[run]) ++run;
+
+                appendCursor(first_row_line_ + y, cell_column_ + x);
+                diff_.append(current + x, current + run);
+                x = run;
+            }
+        }
+
+        if (counter != previous_counter_) {
+            appendCursor(counter_line_, 1);
+            diff_ += counter;
+            diff_ += "\x1b[K";
+        }
+
+        // Курсор под кадр, чтобы следующий вывод не попал в карту
+        appendCursor(total_lines_ + 1, 1);
+    }
+
+    for (int y = 0; y < height_; ++y) {
+        const char* current = frame_.data() + row_offsets_[static_cast<size_t>(y)];
+        std::copy_n(current, width_, previous_.begin() + static_cast<std::ptrdiff_t>(y) * width_);
+    }
+    previous_counter_ = counter;
+    has_previous_ = true;
+}
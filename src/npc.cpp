@@ -3,8 +3,8 @@
 #include <ostream>
 #include <iostream>
 
-Npc::Npc(int x, int y, const std::string& type, const std::string& name)
-    : x_(x), y_(y), type_(type), name_(name), alive_(true) {}
+Npc::Npc(int x, int y, NpcTypeId typeId, std::string_view name)
+    : x_(x), y_(y), name_(name), type_id_(typeId), alive_(true) {}
 
 int Npc::getX() const {
     return x_;
@@ -14,12 +14,16 @@ int Npc::getY() const {
     return y_;
 }
 
-std::string Npc::getType() const {
-    return type_;
+const std::string& Npc::getType() const {
+    return npcTypeString(type_id_);
 }
 
-std::string Npc::getName() const {
-    return name_;
+std::string_view Npc::getName() const {
+    return name_.view();
+}
+
+NpcTypeId Npc::getTypeId() const {
+    return type_id_;
 }
 
 bool Npc::isAlive() const {
@@ -49,8 +53,20 @@ void Npc::printInfo() const {
 }
 
 std::ostream& operator<<(std::ostream& os, const Npc& npc) {
-    os << "NPC Type: " << npc.type_ << ", Name: " << npc.name_
+    os << "NPC Type: " << npc.getType() << ", Name: " << npc.getName()
        << ", Position: (" << npc.x_ << ", " << npc.y_ << ")"
        << ", Status: " << (npc.alive_ ? "Alive" : "Dead");
     return os;
-}
\ No newline at end of file
+}
+
+void NpcDeleter::operator()(Npc* npc) const noexcept {
+    if (!resource) {
+        delete npc;
+        return;
+    }
+
+    // Блок начинается с полного объекта, а не с подобъекта Npc
+    void* memory = dynamic_cast<void*>(npc);
+    npc->~Npc();
+    resource->deallocate(memory, size, kNpcAlignment);
+}
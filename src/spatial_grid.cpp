@@ -0,0 +1,75 @@
+#include "../include/spatial_grid.h"
+#include <algorithm>
+#include <stdexcept>
+
+SpatialGrid::SpatialGrid(int width, int height, int cellSize)
+    : cellSize_(cellSize), size_(0) {
+    if (width <= 0 || height <= 0 || cellSize <= 0) {
+        throw std::invalid_argument("Invalid spatial grid dimensions.");
+    }
+    cols_ = (width + cellSize - 1) / cellSize;
+    rows_ = (height + cellSize - 1) / cellSize;
+    cells_.resize(static_cast<size_t>(cols_) * rows_);
+}
+
+int SpatialGrid::cellCoord(int value, int count) const {
+    // Координаты за пределами мира прижимаются к крайним ячейкам:
+    // это сохраняет соседство пар, расстояние всё равно проверяется точно
+    int c = value < 0 ? 0 : value / cellSize_;
+    return std::min(c, count - 1);
+}
+
+size_t SpatialGrid::cellIndex(int x, int y) const {
+    return static_cast<size_t>(cellCoord(y, rows_)) * cols_ + cellCoord(x, cols_);
+}
+
+void SpatialGrid::erase(size_t cell, Index npc) {
+    auto& entries = cells_[cell];
+    auto it = std::find(entries.begin(), entries.end(), npc);
+    if (it == entries.end()) return;
+
+    *it = entries.back();
+    entries.pop_back();
+    --size_;
+}
+
+void SpatialGrid::insert(Index npc, int x, int y) {
+    cells_[cellIndex(x, y)].push_back(npc);
+    ++size_;
+}
+
+void SpatialGrid::remove(Index npc, int x, int y) {
+    erase(cellIndex(x, y), npc);
+}
+
+void SpatialGrid::update(Index npc, int oldX, int oldY, int newX, int newY) {
+    size_t from = cellIndex(oldX, oldY);
+    size_t to = cellIndex(newX, newY);
+    if (from == to) return;
+
+    size_t before = size_;
+    erase(from, npc);
+    if (size_ == before) return;
+
+    cells_[to].push_back(npc);
+    ++size_;
+}
+
+void SpatialGrid::clear() {
+    for (auto& cell : cells_) {
+        cell.clear();
+    }
+    size_ = 0;
+}
+
+int SpatialGrid::getCellSize() const {
+    return cellSize_;
+}
+
+int SpatialGrid::getRows() const {
+    return rows_;
+}
+
+size_t SpatialGrid::size() const {
+    return size_;
+}
@@ -0,0 +1,56 @@
+#include "../include/text_scenario.h"
+#include <charconv>
+#include <stdexcept>
+
+namespace text_scenario {
+
+namespace {
+
+// Пробельные символы в смысле std::isspace для локали "C"
+constexpr bool isSpace(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+void skipSpaces(const char*& cursor, const char* end) {
+    while (cursor != end && isSpace(*cursor)) ++cursor;
+}
+
+bool readToken(const char*& cursor, const char* end, std::string_view& token) {
+    skipSpaces(cursor, end);
+    const char* begin = cursor;
+    while (cursor != end && !isSpace(*cursor)) ++cursor;
+    token = std::string_view(begin, static_cast<size_t>(cursor - begin));
+    return !token.empty();
+}
+
+// Как operator>> для int: знак + или -, затем цифры; остаток поля не читается
+bool readInt(const char*& cursor, const char* end, int& value) {
+    skipSpaces(cursor, end);
+    if (cursor != end && *cursor == '+' && cursor + 1 != end && *(cursor + 1) != '-') {
+        ++cursor;
+    }
+
+    auto result = std::from_chars(cursor, end, value);
+    if (result.ec != std::errc()) return false;
+    cursor = result.ptr;
+    return true;
+}
+
+}
+
+bool parseLine(std::string_view line, Record& record) {
+    const char* cursor = line.data();
+    const char* end = line.data() + line.size();
+
+    return readToken(cursor, end, record.type) &&
+           readToken(cursor, end, record.name) &&
+           readInt(cursor, end, record.x) &&
+           readInt(cursor, end, record.y);
+}
+
+void throwBadLine(size_t lineNumber, std::string_view line) {
+    throw std::runtime_error("Failed to read line " + std::to_string(lineNumber) + ": " +
+                             std::string(line));
+}
+
+}
@@ -0,0 +1,168 @@
+#include "../include/thread_pool.h"
+#include <exception>
+#include <memory>
+
+namespace {
+
+// Пул и номер рабочего текущего потока (nullptr вне пулов)
+thread_local const ThreadPool* tls_pool = nullptr;
+thread_local size_t tls_index = 0;
+
+}
+
+ThreadPool::ThreadPool(size_t workers)
+    : pending_(0), stopping_(false), next_queue_(0), executed_(0), stolen_(0) {
+    if (workers == 0) workers = 1;
+
+    for (size_t i = 0; i < workers; ++i) {
+        queues_.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < workers; ++i) {
+        threads_.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+size_t ThreadPool::size() const {
+    return queues_.size();
+}
+
+size_t ThreadPool::currentWorker() const {
+    return tls_pool == this ? tls_index : size();
+}
+
+std::future<void> ThreadPool::submit(Task task) {
+    // std::function копируемая, поэтому packaged_task - через shared_ptr
+    auto packaged = std::make_shared<std::packaged_task<void()>>(std::move(task));
+    std::future<void> result = packaged->get_future();
+    enqueue([packaged] { (*packaged)(); });
+    return result;
+}
+
+void ThreadPool::enqueue(Task task) {
+    // Рабочий кладёт в свою деку, внешний поток - по кругу
+    size_t target = currentWorker();
+    if (target == size()) {
+        target = next_queue_.fetch_add(1, std::memory_order_relaxed) % size();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+        queues_[target]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        pending_.fetch_add(1);
+    }
+    wake_.notify_one();
+}
+
+bool ThreadPool::tryRunOne(size_t self) {
+    Task task;
+    bool stolen = false;
+
+    if (self < size()) {
+        Worker& own = *queues_[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+        }
+    }
+
+    // Кража с начала чужих дек, начиная с соседа
+    for (size_t k = 1; !task && k <= size(); ++k) {
+        size_t victim = (self + k) % size();
+        if (victim == self) continue;
+
+        Worker& other = *queues_[victim];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if (!other.tasks.empty()) {
+            task = std::move(other.tasks.front());
+            other.tasks.pop_front();
+            stolen = self < size();
+        }
+    }
+
+    if (!task) return false;
+
+    pending_.fetch_sub(1);
+    task();
+    executed_.fetch_add(1, std::memory_order_relaxed);
+    if (stolen) stolen_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    tls_pool = this;
+    tls_index = index;
+
+    for (;;) {
+        if (tryRunOne(index)) continue;
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        wake_.wait(lock, [this] { return stopping_ || pending_.load() > 0; });
+        if (stopping_ && pending_.load() == 0) return;
+    }
+}
+
+void ThreadPool::run(std::vector<Task> tasks) {
+    if (tasks.empty()) return;
+
+    // Состояние пачки живёт, пока его держит хоть одна задача: последняя
+    // задача будит вызывающего уже после того, как тот мог бы вернуться
+    struct Batch {
+        std::atomic<size_t> remaining;
+        std::exception_ptr error;
+        std::mutex error_mutex;
+    };
+    auto batch = std::make_shared<Batch>();
+    batch->remaining.store(tasks.size());
+
+    for (auto& task : tasks) {
+        enqueue([batch, task = std::move(task)] {
+            try {
+                task();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(batch->error_mutex);
+                if (!batch->error) batch->error = std::current_exception();
+            }
+            if (batch->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                batch->remaining.notify_all();
+            }
+        });
+    }
+
+    // Пока пачка не готова, помогаем выполнять задачи. Если брать нечего,
+    // оставшиеся задачи пачки уже выполняются другими потоками - спим,
+    // пока последняя из них не обнулит счётчик
+    size_t self = currentWorker();
+    for (;;) {
+        size_t remaining = batch->remaining.load(std::memory_order_acquire);
+        if (remaining == 0) break;
+        if (!tryRunOne(self)) {
+            batch->remaining.wait(remaining, std::memory_order_acquire);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(batch->error_mutex);
+    if (batch->error) std::rethrow_exception(batch->error);
+}
+
+ThreadPoolStats ThreadPool::getStats() const {
+    ThreadPoolStats stats{};
+    stats.executed = executed_.load(std::memory_order_relaxed);
+    stats.stolen = stolen_.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,66 @@
+#include "../include/tick_scheduler.h"
+#include <utility>
+
+TickTask::TickTask(TickTask&& other) noexcept
+    : handle_(std::exchange(other.handle_, nullptr)) {}
+
+TickTask& TickTask::operator=(TickTask&& other) noexcept {
+    if (this != &other) {
+        if (handle_) handle_.destroy();
+        handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+}
+
+TickTask::~TickTask() {
+    if (handle_) handle_.destroy();
+}
+
+TickScheduler::~TickScheduler() {
+    clear();
+}
+
+void TickScheduler::spawn(TickTask task) {
+    next_.push_back(task.handle_);
+    tasks_.push_back(std::move(task));
+}
+
+void TickScheduler::runTick() {
+    ready_.swap(next_);
+    next_.clear();
+    ++tick_;
+
+    for (size_t i = 0; i < ready_.size(); ++i) {
+        TickTask::Handle handle = ready_[i];
+        handle.resume();
+        ++resumes_;
+
+        // Корутина завершилась с исключением: остальные ждущие этого шага
+        // переносятся на следующий, ошибка уходит вызывающему
+        if (handle.done() && handle.promise().error) {
+            std::exception_ptr error = std::exchange(handle.promise().error, nullptr);
+            next_.insert(next_.begin(), ready_.begin() + i + 1, ready_.end());
+            ready_.clear();
+            std::rethrow_exception(error);
+        }
+    }
+    ready_.clear();
+}
+
+void TickScheduler::clear() {
+    ready_.clear();
+    next_.clear();
+    tasks_.clear();
+}
+
+size_t TickScheduler::size() const {
+    return tasks_.size();
+}
+
+std::uint64_t TickScheduler::getTick() const {
+    return tick_;
+}
+
+std::uint64_t TickScheduler::getResumes() const {
+    return resumes_;
+}
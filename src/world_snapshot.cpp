@@ -0,0 +1,18 @@
+#include "../include/world_snapshot.h"
+#include <algorithm>
+
+size_t WorldSnapshot::aliveCount() const {
+    return static_cast<size_t>(std::count(alive.begin(), alive.end(), std::uint8_t{1}));
+}
+
+std::vector<std::string> WorldSnapshot::survivors() const {
+    std::vector<std::string> result;
+    for (size_t i = 0; i < size(); ++i) {
+        if (isAlive(i)) {
+            result.push_back(getName(i));
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
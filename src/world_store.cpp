@@ -0,0 +1,164 @@
+#include "../include/world_store.h"
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::uint64_t kIndexMask = 0xffffffffu;
+
+std::uint64_t makeSlot(std::uint64_t hash, WorldStore::Index i) {
+    return (hash & ~kIndexMask) | (static_cast<std::uint64_t>(i) + 1);
+}
+
+// Смещения имён 32-битные: все имена мира - не больше 4 ГиБ символов
+std::uint32_t nameOffset(size_t offset) {
+    if (offset > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::length_error("World names exceed 4 GiB.");
+    }
+    return static_cast<std::uint32_t>(offset);
+}
+
+}
+
+std::uint64_t WorldStore::hashName(std::string_view name) {
+    return std::hash<std::string_view>{}(name);
+}
+
+size_t WorldStore::probe(std::string_view name, std::uint64_t hash) const {
+    size_t mask = slots_.size() - 1;
+    for (size_t s = hash & mask;; s = (s + 1) & mask) {
+        std::uint64_t slot = slots_[s];
+        if (slot == 0) return s;
+        if ((slot & ~kIndexMask) == (hash & ~kIndexMask) &&
+            getName(static_cast<Index>((slot & kIndexMask) - 1)) == name) {
+            return s;
+        }
+    }
+}
+
+void WorldStore::rehash(size_t count) {
+    size_t capacity = std::bit_ceil(std::max<size_t>(16, count * 2));
+    if (capacity <= slots_.size()) return;
+
+    slots_.assign(capacity, 0);
+    size_t mask = capacity - 1;
+    for (Index i = 0; i < size(); ++i) {
+        std::uint64_t hash = hashName(getName(i));
+        size_t s = hash & mask;
+        while (slots_[s] != 0) s = (s + 1) & mask;
+        slots_[s] = makeSlot(hash, i);
+    }
+}
+
+WorldStore::Index WorldStore::add(std::string_view name, TypeId type_id,
+                                  int x, int y, bool alive) {
+    rehash(size() + 1);
+
+    // Один проход по таблице и для замены, и для вставки
+    std::uint64_t hash = hashName(name);
+    size_t s = probe(name, hash);
+    if (slots_[s] != 0) {
+        Index i = static_cast<Index>((slots_[s] & kIndexMask) - 1);
+        x_[i] = x;
+        y_[i] = y;
+        type_id_[i] = type_id;
+        alive_[i] = alive ? 1 : 0;
+        return i;
+    }
+
+    Index i = static_cast<Index>(x_.size());
+    std::uint32_t end = nameOffset(name_chars_.size() + name.size());
+    name_chars_.insert(name_chars_.end(), name.begin(), name.end());
+    name_offsets_.push_back(end);
+    slots_[s] = makeSlot(hash, i);
+    x_.push_back(x);
+    y_.push_back(y);
+    type_id_.push_back(type_id);
+    alive_.push_back(alive ? 1 : 0);
+    return i;
+}
+
+WorldStore::Index WorldStore::append(const std::vector<std::string>& names, const std::vector<TypeId>& types,
+                                     const std::vector<int>& xs, const std::vector<int>& ys,
+                                     ThreadPool& pool, size_t grain) {
+    Index first = static_cast<Index>(x_.size());
+
+    // Смещения - префиксные суммы длин; символы копируются параллельно ниже
+    std::vector<std::uint32_t> offsets(names.size());
+    size_t end = name_chars_.size();
+    for (size_t j = 0; j < names.size(); ++j) {
+        end += names[j].size();
+        offsets[j] = nameOffset(end);
+    }
+
+    rehash(first + names.size());
+    x_.insert(x_.end(), xs.begin(), xs.end());
+    y_.insert(y_.end(), ys.begin(), ys.end());
+    type_id_.insert(type_id_.end(), types.begin(), types.end());
+    alive_.resize(alive_.size() + names.size(), 1);
+    name_offsets_.insert(name_offsets_.end(), offsets.begin(), offsets.end());
+    name_chars_.resize(end);
+
+    // Имена новые и различны, поэтому вставке достаточно занять пустой слот:
+    // потоки соревнуются только за слоты, занятый слот пропускается
+    size_t mask = slots_.size() - 1;
+    pool.parallelFor(0, names.size(), grain, [&](size_t from, size_t to) {
+        for (size_t j = from; j < to; ++j) {
+            Index i = first + static_cast<Index>(j);
+            std::uint64_t hash = hashName(names[j]);
+            std::uint64_t slot = makeSlot(hash, i);
+            for (size_t s = hash & mask;; s = (s + 1) & mask) {
+                std::uint64_t expected = 0;
+                if (std::atomic_ref<std::uint64_t>(slots_[s])
+                        .compare_exchange_strong(expected, slot, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            std::memcpy(name_chars_.data() + name_offsets_[i], names[j].data(), names[j].size());
+        }
+    });
+    return first;
+}
+
+WorldStore::Index WorldStore::find(std::string_view name) const {
+    if (slots_.empty()) return kNotFound;
+    std::uint64_t slot = slots_[probe(name, hashName(name))];
+    return slot == 0 ? kNotFound : static_cast<Index>((slot & kIndexMask) - 1);
+}
+
+size_t WorldStore::size() const {
+    return x_.size();
+}
+
+void WorldStore::clear() {
+    x_.clear();
+    y_.clear();
+    type_id_.clear();
+    alive_.clear();
+    name_chars_.clear();
+    name_offsets_.assign(1, 0);
+    slots_.clear();
+}
+
+void WorldStore::reserve(size_t count) {
+    x_.reserve(count);
+    y_.reserve(count);
+    type_id_.reserve(count);
+    alive_.reserve(count);
+    name_offsets_.reserve(count + 1);
+    rehash(count);
+}
+
+std::vector<std::string> WorldStore::copyNames() const {
+    std::vector<std::string> names;
+    names.reserve(size());
+    for (Index i = 0; i < size(); ++i) {
+        names.emplace_back(getName(i));
+    }
+    return names;
+}
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include "../include/async_file_observer.h"
+#include "../include/arena.h"
+#include "../include/factory.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> readLines(const std::string& filename) {
+    std::vector<std::string> lines;
+    std::ifstream file(filename);
+    std::string line;
+    while (std::getline(file, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+}
+
+TEST(AsyncFileObserverTest, DestructorWritesAllEventsInOrder) {
+    std::string logfile = "test_async_observer_order.txt";
+    std::remove(logfile.c_str());
+
+    {
+        AsyncFileObserver observer(logfile);
+        for (int i = 0; i < 10000; ++i) {
+            observer.notify("event " + std::to_string(i));
+        }
+    }
+
+    std::vector<std::string> lines = readLines(logfile);
+    ASSERT_EQ(lines.size(), 10000u);
+    for (int i = 0; i < 10000; ++i) {
+        EXPECT_EQ(lines[i], "event " + std::to_string(i));
+    }
+    std::remove(logfile.c_str());
+}
+
+TEST(AsyncFileObserverTest, FlushMakesEventsVisible) {
+    std::string logfile = "test_async_observer_flush.txt";
+    std::remove(logfile.c_str());
+
+    // Интервал и размер блока такие, что сам писатель не проснётся
+    AsyncFileObserver::Config config;
+    config.flush_size = 1000000;
+    config.flush_interval = std::chrono::hours(1);
+    AsyncFileObserver observer(logfile, config);
+
+    observer.notify("first");
+    observer.notify("second");
+    observer.flush();
+
+    EXPECT_EQ(observer.getWritten(), 2u);
+    EXPECT_EQ(readLines(logfile), (std::vector<std::string>{"first", "second"}));
+
+    observer.notify("third");
+    observer.flush();
+    EXPECT_EQ(readLines(logfile).size(), 3u);
+    std::remove(logfile.c_str());
+}
+
+TEST(AsyncFileObserverTest, FlushSizeWakesWriter) {
+    std::string logfile = "test_async_observer_size.txt";
+    std::remove(logfile.c_str());
+
+    AsyncFileObserver::Config config;
+    config.flush_size = 8;
+    config.flush_interval = std::chrono::hours(1);
+    AsyncFileObserver observer(logfile, config);
+
+    for (int i = 0; i < 8; ++i) {
+        observer.notify("event");
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (observer.getWritten() < 8 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(observer.getWritten(), 8u);
+    std::remove(logfile.c_str());
+}
+
+TEST(AsyncFileObserverTest, DropPolicyBoundsQueue) {
+    std::string logfile = "test_async_observer_drop.txt";
+    std::remove(logfile.c_str());
+
+    {
+        AsyncFileObserver::Config config;
+        config.capacity = 16;
+        config.flush_size = 1000000;
+        config.flush_interval = std::chrono::hours(1);
+        config.overflow = AsyncFileObserver::Overflow::Drop;
+        AsyncFileObserver observer(logfile, config);
+
+        for (int i = 0; i < 26; ++i) {
+            observer.notify("event " + std::to_string(i));
+        }
+        EXPECT_EQ(observer.getDropped(), 10u);
+    }
+
+    std::vector<std::string> lines = readLines(logfile);
+    ASSERT_EQ(lines.size(), 16u);
+    EXPECT_EQ(lines.back(), "event 15");
+    std::remove(logfile.c_str());
+}
+
+TEST(AsyncFileObserverTest, BlockPolicyKeepsEventsFromManyThreads) {
+    std::string logfile = "test_async_observer_threads.txt";
+    std::remove(logfile.c_str());
+
+    const int threads = 4;
+    const int per_thread = 5000;
+    {
+        AsyncFileObserver::Config config;
+        config.capacity = 64;
+        config.flush_size = 16;
+        AsyncFileObserver observer(logfile, config);
+
+        std::vector<std::thread> producers;
+        for (int t = 0; t < threads; ++t) {
+            producers.emplace_back([&observer, t] {
+                for (int i = 0; i < per_thread; ++i) {
+                    observer.notify(std::to_string(t) + " " + std::to_string(i));
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        EXPECT_EQ(observer.getDropped(), 0u);
+    }
+
+    // Все события на месте, порядок внутри потока сохранён
+    std::vector<int> next(threads, 0);
+    std::vector<std::string> lines = readLines(logfile);
+    ASSERT_EQ(lines.size(), static_cast<size_t>(threads * per_thread));
+    for (const std::string& line : lines) {
+        size_t space = line.find(' ');
+        int t = std::stoi(line.substr(0, space));
+        int i = std::stoi(line.substr(space + 1));
+        EXPECT_EQ(i, next[t]++);
+    }
+    std::remove(logfile.c_str());
+}
+
+TEST(AsyncFileObserverTest, AppendsToExistingFile) {
+    std::string logfile = "test_async_observer_append.txt";
+    {
+        std::ofstream file(logfile, std::ios::trunc);
+        file << "old\n";
+    }
+
+    {
+        AsyncFileObserver observer(logfile);
+        observer.notify("new");
+    }
+
+    EXPECT_EQ(readLines(logfile), (std::vector<std::string>{"old", "new"}));
+    std::remove(logfile.c_str());
+}
+
+TEST(AsyncFileObserverTest, RejectsBadConfigAndPath) {
+    AsyncFileObserver::Config config;
+    config.flush_size = 0;
+    EXPECT_THROW(AsyncFileObserver("test_async_observer_bad.txt", config), std::invalid_argument);
+    std::remove("test_async_observer_bad.txt");
+
+    EXPECT_THROW(AsyncFileObserver("no_such_dir/log.txt"), std::runtime_error);
+}
+
+TEST(AsyncFileObserverTest, LogsArenaBattle) {
+    std::string logfile = "test_async_observer_battle.txt";
+    std::remove(logfile.c_str());
+
+    {
+        Arena arena;
+        arena.addObserver(std::make_shared<AsyncFileObserver>(logfile));
+        arena.addNpc(NpcFactory::createNpc("Knight", "Knight1", 100, 100));
+        arena.addNpc(NpcFactory::createNpc("Elf", "Elf1", 110, 110));
+        arena.startBattle(50.0);
+    }
+
+    EXPECT_FALSE(readLines(logfile).empty());
+    std::remove(logfile.c_str());
+}
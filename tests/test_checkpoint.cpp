@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+#include "../include/checkpoint.h"
+#include "../include/game_engine.h"
+#include "../include/factory.h"
+#include "test_helpers.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+void makeWorld(GameEngine& engine, std::uint64_t seed, GameEngine::ExecutionMode mode) {
+    engine.setSeed(seed);
+    engine.setWorkerCount(2);
+    engine.setExecutionMode(mode);
+    engine.setTickConfig(headless());
+    engine.createRandomNpcs(1500);
+}
+
+void run(GameEngine& engine, std::uint64_t ticks) {
+    testing::internal::CaptureStdout();
+    engine.runTicks(ticks);
+    testing::internal::GetCapturedStdout();
+}
+
+void removeAll(const std::vector<std::string>& files) {
+    for (const auto& file : files) std::remove(file.c_str());
+}
+
+}
+
+// Тесты контрольных точек
+TEST(CheckpointTest, ResumeMatchesContinuousRun) {
+    for (auto mode : {GameEngine::ExecutionMode::Threaded, GameEngine::ExecutionMode::Coroutines}) {
+        GameEngine continuous(300, 300);
+        makeWorld(continuous, 77, mode);
+        run(continuous, 20);
+        continuous.checkpoint("temp_resume.ckpt");
+        run(continuous, 30);
+        continuous.waitForCheckpoints();
+
+        GameEngine resumed(300, 300);
+        resumed.setExecutionMode(mode);
+        resumed.setTickConfig(headless());
+        resumed.resumeFromCheckpoint({"temp_resume.ckpt"});
+        EXPECT_EQ(resumed.getTick(), 20);
+        EXPECT_EQ(resumed.getSeed(), 77);
+        run(resumed, 30);
+
+        EXPECT_EQ(resumed.getTick(), continuous.getTick());
+        EXPECT_EQ(resumed.getSurvivors(), continuous.getSurvivors());
+        EXPECT_EQ(resumed.getSnapshot()->xs, continuous.getSnapshot()->xs);
+        std::remove("temp_resume.ckpt");
+    }
+}
+
+TEST(CheckpointTest, PeriodicDeltaChain) {
+    GameEngine engine(300, 300);
+    makeWorld(engine, 5, GameEngine::ExecutionMode::Threaded);
+
+    GameEngine::CheckpointConfig config;
+    config.prefix = "temp_periodic";
+    config.every_ticks = 5;
+    config.delta = true;
+    config.full_every = 3;
+    engine.setCheckpointConfig(config);
+
+    run(engine, 35);
+    engine.waitForCheckpoints();
+
+    // Точки на шагах 5..35: полные на 5, 20, 35; цепочка - последняя полная
+    std::vector<std::string> chain = engine.getCheckpointChain();
+    ASSERT_EQ(chain.size(), 1u);
+    EXPECT_EQ(chain[0], "temp_periodic-35.ckpt");
+
+    run(engine, 10);
+    engine.waitForCheckpoints();
+    chain = engine.getCheckpointChain();
+    ASSERT_EQ(chain, (std::vector<std::string>{"temp_periodic-35.ckpt", "temp_periodic-40.ckpt",
+                                                "temp_periodic-45.ckpt"}));
+
+    checkpoint::State state = checkpoint::load(chain);
+    auto snapshot = engine.getSnapshot();
+    EXPECT_EQ(state.tick, 45);
+    EXPECT_EQ(state.xs, snapshot->xs);
+    EXPECT_EQ(state.ys, snapshot->ys);
+    EXPECT_EQ(state.alive, snapshot->alive);
+    EXPECT_EQ(state.names, *snapshot->names);
+
+    std::vector<std::string> written;
+    for (int tick = 5; tick <= 45; tick += 5) {
+        written.push_back("temp_periodic-" + std::to_string(tick) + ".ckpt");
+    }
+    for (const auto& file : written) {
+        EXPECT_TRUE(std::filesystem::exists(file)) << file;
+    }
+    removeAll(written);
+}
+
+TEST(CheckpointTest, DeltaHoldsOnlyChangedNpcs) {
+    GameEngine engine(100, 100);
+    engine.setTickConfig(headless());
+    engine.addNpc(NpcFactory::createNpc("Knight", "Knight1", 10, 10));
+    engine.addNpc(NpcFactory::createNpc("Elf", "Elf1", 90, 90));
+
+    engine.checkpoint("temp_base.ckpt");
+    engine.checkpoint("temp_same.ckpt", true);
+    run(engine, 1);
+    engine.checkpoint("temp_moved.ckpt", true);
+    engine.waitForCheckpoints();
+
+    // Без шагов между точками разностная точка - только заголовок
+    EXPECT_EQ(std::filesystem::file_size("temp_same.ckpt"), sizeof(checkpoint::Header));
+    EXPECT_LE(std::filesystem::file_size("temp_moved.ckpt"),
+              sizeof(checkpoint::Header) + 2 * sizeof(checkpoint::DeltaRecord));
+
+    checkpoint::State state = checkpoint::load({"temp_base.ckpt", "temp_same.ckpt", "temp_moved.ckpt"});
+    EXPECT_EQ(state.tick, 1);
+    EXPECT_EQ(state.xs, engine.getSnapshot()->xs);
+
+    // После addNpc разностная точка невозможна - пишется полная
+    engine.addNpc(NpcFactory::createNpc("Druid", "Druid1", 50, 50));
+    engine.checkpoint("temp_added.ckpt", true);
+    EXPECT_EQ(engine.getCheckpointChain(), std::vector<std::string>{"temp_added.ckpt"});
+    engine.waitForCheckpoints();
+
+    removeAll({"temp_base.ckpt", "temp_same.ckpt", "temp_moved.ckpt", "temp_added.ckpt"});
+}
+
+TEST(CheckpointTest, RejectsBrokenChains) {
+    GameEngine engine(100, 100);
+    engine.setTickConfig(headless());
+    engine.createRandomNpcs(20);
+
+    engine.checkpoint("temp_a.ckpt");
+    run(engine, 2);
+    engine.checkpoint("temp_b.ckpt", true);
+    run(engine, 2);
+    engine.checkpoint("temp_c.ckpt", true);
+    engine.waitForCheckpoints();
+
+    EXPECT_NO_THROW(checkpoint::load({"temp_a.ckpt", "temp_b.ckpt", "temp_c.ckpt"}));
+    EXPECT_THROW(checkpoint::load({"temp_a.ckpt", "temp_c.ckpt"}), std::runtime_error);
+    EXPECT_THROW(checkpoint::load({"temp_b.ckpt"}), std::runtime_error);
+    EXPECT_THROW(checkpoint::load({"temp_missing.ckpt"}), std::runtime_error);
+    EXPECT_THROW(checkpoint::load({}), std::invalid_argument);
+
+    GameEngine other(200, 200);
+    EXPECT_THROW(other.resumeFromCheckpoint({"temp_a.ckpt"}), std::invalid_argument);
+
+    removeAll({"temp_a.ckpt", "temp_b.ckpt", "temp_c.ckpt"});
+}
+
+TEST(CheckpointTest, CheckpointWhileRunning) {
+    GameEngine engine(300, 300);
+    makeWorld(engine, 9, GameEngine::ExecutionMode::Threaded);
+
+    std::thread runner([&] { engine.runTicks(100); });
+    std::vector<std::string> files;
+    for (int k = 0; k < 10; ++k) {
+        files.push_back("temp_live_" + std::to_string(k) + ".ckpt");
+        engine.checkpoint(files.back());
+        std::this_thread::yield();
+    }
+    runner.join();
+    engine.waitForCheckpoints();
+
+    // Каждая точка - целостный снимок своего шага
+    for (const auto& file : files) {
+        checkpoint::State state = checkpoint::load({file});
+        EXPECT_EQ(state.names.size(), 1500u);
+        EXPECT_LE(state.tick, 100u);
+    }
+    removeAll(files);
+}
+
+// Точка пишется через временный файл: после записи его не остаётся, а
+// неудачная запись не создаёт файла под именем точки
+TEST(CheckpointTest, WritesThroughTemporaryFile) {
+    TempDir dir;
+    const std::string file = dir.file("atomic.ckpt");
+
+    GameEngine engine(100, 100);
+    engine.setTickConfig(headless());
+    engine.createRandomNpcs(50);
+    engine.checkpoint(file);
+    run(engine, 3);
+    engine.checkpoint(file);  // поверх прежней точки
+    engine.waitForCheckpoints();
+
+    EXPECT_FALSE(std::filesystem::exists(file + ".tmp"));
+    EXPECT_EQ(checkpoint::load({file}).tick, 3);
+
+    const std::string missing = dir.file("missing/atomic.ckpt");
+    EXPECT_THROW(checkpoint::write(missing, *engine.getSnapshot(), nullptr, 1), std::runtime_error);
+    EXPECT_FALSE(std::filesystem::exists(missing));
+    EXPECT_FALSE(std::filesystem::exists(missing + ".tmp"));
+}
+
+// Новый процесс находит цепочку последней точки по заголовкам файлов
+TEST(CheckpointTest, FindsChainAfterRestart) {
+    TempDir dir;
+    const std::string prefix = dir.file("run");
+
+    GameEngine engine(300, 300);
+    makeWorld(engine, 31, GameEngine::ExecutionMode::Threaded);
+    GameEngine::CheckpointConfig config;
+    config.prefix = prefix;
+    config.every_ticks = 5;
+    config.delta = true;
+    config.full_every = 3;
+    engine.setCheckpointConfig(config);
+    run(engine, 40);
+    engine.waitForCheckpoints();
+
+    // Чужой файл с подходящим именем не мешает поиску
+    std::ofstream(prefix + "-999.ckpt") << "not a checkpoint";
+
+    std::vector<std::string> chain = checkpoint::findChain(prefix);
+    EXPECT_EQ(chain, engine.getCheckpointChain());
+    EXPECT_EQ(chain, (std::vector<std::string>{prefix + "-35.ckpt", prefix + "-40.ckpt"}));
+
+    GameEngine resumed(300, 300);
+    resumed.setTickConfig(headless());
+    resumed.resumeFromCheckpoint(chain);
+    EXPECT_EQ(resumed.getTick(), 40);
+    EXPECT_EQ(resumed.getSurvivors(), engine.getSurvivors());
+
+    // Без полной точки последней цепочки - предыдущая целая цепочка
+    std::filesystem::remove(prefix + "-35.ckpt");
+    EXPECT_EQ(checkpoint::findChain(prefix),
+              (std::vector<std::string>{prefix + "-20.ckpt", prefix + "-25.ckpt", prefix + "-30.ckpt"}));
+    EXPECT_TRUE(checkpoint::findChain(dir.file("other")).empty());
+}
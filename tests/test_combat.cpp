@@ -1,11 +1,16 @@
 #include <gtest/gtest.h>
 #include "../include/combat_visitor.h"
+#include "../include/combat_rules.h"
 #include "../include/arena.h"
 #include "../include/factory.h"
 #include "../include/console_observer.h"
 #include "../include/file_observer.h"
 #include <memory>
 #include <fstream>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
 
 // Тесты боевой системы
 TEST(CombatTest, KnightVsKnight) {
@@ -204,3 +209,181 @@ TEST(CombatTest, FileObserverLogging) {
     // Удаляем тестовый файл
     std::remove(logfile.c_str());
 }
+
+namespace {
+
+// Наблюдатель, запоминающий все события боя
+class RecordingObserver : public Observer {
+    public:
+        void notify(const std::string& event) override {
+            events.push_back(event);
+        }
+
+        std::vector<std::string> events;
+};
+
+std::vector<std::string> runBattle(Arena::BattleMode mode, double range) {
+    Arena arena;
+    arena.setBattleMode(mode);
+    auto observer = std::make_shared<RecordingObserver>();
+    arena.addObserver(observer);
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> coord(0, 500);
+    const char* types[] = {"Knight", "Druid", "Elf"};
+    for (int i = 0; i < 400; ++i) {
+        arena.addNpc(NpcFactory::createNpc(types[i % 3], "Npc" + std::to_string(i),
+                                           coord(gen), coord(gen)));
+    }
+
+    arena.startBattle(range);
+    observer->events.push_back("left: " + std::to_string(arena.getNpcCount()));
+    return observer->events;
+}
+
+}
+
+TEST(CombatTest, SweepAndPruneMatchesBruteForce) {
+    for (double range : {0.0, 15.0, 40.0, 120.0}) {
+        auto brute = runBattle(Arena::BattleMode::BruteForce, range);
+        auto sweep = runBattle(Arena::BattleMode::SweepAndPrune, range);
+        EXPECT_EQ(brute, sweep) << "range = " << range;
+    }
+}
+
+namespace {
+
+// Типизированный наблюдатель: считает события и пишет двоичный журнал
+// (вид события и типы участников), текст не запрашивает
+class TypedObserver : public Observer {
+    public:
+        void onBattleEvent(const BattleEvent& event) override {
+            ++(event.kind == BattleEvent::Kind::MutualKill ? mutual : kills);
+            log.push_back(static_cast<std::uint8_t>(event.kind));
+            log.push_back(static_cast<std::uint8_t>(event.attacker->getTypeId()));
+            log.push_back(static_cast<std::uint8_t>(event.defender->getTypeId()));
+            texts.push_back(event.text());
+        }
+
+        int kills = 0;
+        int mutual = 0;
+        std::vector<std::uint8_t> log;
+        std::vector<std::string> texts;
+};
+
+}
+
+TEST(CombatTest, BattleEventKindsAndText) {
+    Arena arena;
+    auto typed = std::make_shared<TypedObserver>();
+    auto legacy = std::make_shared<RecordingObserver>();
+    arena.addObserver(typed);
+    arena.addObserver(legacy);
+
+    // Рыцарь и эльф убивают друг друга, эльф убивает друида
+    arena.addNpc(NpcFactory::createNpc("Knight", "Knight1", 0, 0));
+    arena.addNpc(NpcFactory::createNpc("Elf", "Elf1", 5, 0));
+    arena.addNpc(NpcFactory::createNpc("Druid", "Druid1", 400, 400));
+    arena.addNpc(NpcFactory::createNpc("Elf", "Elf2", 405, 400));
+    arena.startBattle(10.0);
+
+    EXPECT_EQ(typed->mutual, 1);
+    EXPECT_EQ(typed->kills, 1);
+    std::vector<std::string> expected = {
+        "Elf2 (Elf) killed Druid1 (Druid)",
+        "Elf1 (Elf) and Knight1 (Knight) killed each other",
+    };
+    EXPECT_EQ(typed->texts, expected);
+    EXPECT_EQ(legacy->events, expected);
+
+    std::vector<std::uint8_t> log = {
+        static_cast<std::uint8_t>(BattleEvent::Kind::Kill),
+        static_cast<std::uint8_t>(NpcTypeId::Elf), static_cast<std::uint8_t>(NpcTypeId::Druid),
+        static_cast<std::uint8_t>(BattleEvent::Kind::MutualKill),
+        static_cast<std::uint8_t>(NpcTypeId::Elf), static_cast<std::uint8_t>(NpcTypeId::Knight),
+    };
+    EXPECT_EQ(typed->log, log);
+    EXPECT_EQ(arena.getNpcCount(), 1);
+}
+
+TEST(CombatTest, BattleEventTextIsBuiltOnce) {
+    auto knight = NpcFactory::createNpc("Knight", "Knight1", 0, 0);
+    auto elf = NpcFactory::createNpc("Elf", "Elf1", 0, 0);
+    BattleEvent event(BattleEvent::Kind::Kill, knight.get(), elf.get());
+
+    const std::string& text = event.text();
+    EXPECT_EQ(text, "Knight1 (Knight) killed Elf1 (Elf)");
+    EXPECT_EQ(&event.text(), &text);
+
+    std::string out = "> ";
+    event.appendTo(out);
+    EXPECT_EQ(out, "> Knight1 (Knight) killed Elf1 (Elf)");
+}
+
+// Тесты таблицы правил
+TEST(CombatTest, DefaultRulesTable) {
+    const CombatRules& rules = kDefaultCombatRules;
+
+    EXPECT_TRUE(rules.canKill(NpcTypeId::Knight, NpcTypeId::Elf));
+    EXPECT_TRUE(rules.canKill(NpcTypeId::Elf, NpcTypeId::Knight));
+    EXPECT_TRUE(rules.canKill(NpcTypeId::Elf, NpcTypeId::Druid));
+    EXPECT_TRUE(rules.canKill(NpcTypeId::Druid, NpcTypeId::Druid));
+    EXPECT_FALSE(rules.canKill(NpcTypeId::Druid, NpcTypeId::Elf));
+    EXPECT_FALSE(rules.canKill(NpcTypeId::Unknown, NpcTypeId::Knight));
+    EXPECT_FALSE(rules.canKill(NpcTypeId::Elf, NpcTypeId::Unknown));
+
+    EXPECT_EQ(rules.getStats(NpcTypeId::Knight).movement_distance, 30);
+    EXPECT_EQ(rules.getStats(NpcTypeId::Elf).kill_distance, 50);
+    EXPECT_EQ(rules.maxKillDistance(), 50);
+
+    static_assert(kCanKill<NpcTypeId::Druid, NpcTypeId::Druid>);
+    static_assert(kDefaultCombatRules.getStats(NpcTypeId::Druid).kill_distance == 10);
+}
+
+TEST(CombatTest, LoadRulesFromFile) {
+    std::string filename = "test_rules.txt";
+    {
+        std::ofstream out(filename);
+        out << "# Рыцари против всех\n";
+        out << "stats Knight 5 20\n";
+        out << "kills Knight Druid Elf\n";
+        out << "\n";
+        out << "kills Elf Elf  # эльфы дерутся между собой\n";
+    }
+
+    CombatRules rules = CombatRules::loadFromFile(filename);
+    std::remove(filename.c_str());
+
+    EXPECT_TRUE(rules.canKill(NpcTypeId::Knight, NpcTypeId::Druid));
+    EXPECT_TRUE(rules.canKill(NpcTypeId::Knight, NpcTypeId::Elf));
+    EXPECT_TRUE(rules.canKill(NpcTypeId::Elf, NpcTypeId::Elf));
+    EXPECT_FALSE(rules.canKill(NpcTypeId::Elf, NpcTypeId::Knight));
+    EXPECT_FALSE(rules.canKill(NpcTypeId::Druid, NpcTypeId::Druid));
+    EXPECT_EQ(rules.getStats(NpcTypeId::Knight).movement_distance, 5);
+    EXPECT_EQ(rules.getStats(NpcTypeId::Knight).kill_distance, 20);
+
+    // Активные правила видит CombatVisitor
+    CombatRules::setActive(rules);
+    CombatVisitor visitor;
+    auto knight = NpcFactory::createNpc("Knight", "Knight1", 0, 0);
+    auto druid = NpcFactory::createNpc("Druid", "Druid1", 0, 0);
+    EXPECT_TRUE(visitor.canKill(knight.get(), druid.get()));
+    CombatRules::setActive(kDefaultCombatRules);
+    EXPECT_FALSE(visitor.canKill(knight.get(), druid.get()));
+}
+
+TEST(CombatTest, LoadRulesInvalidFile) {
+    EXPECT_THROW({
+        CombatRules::loadFromFile("nonexistent_rules.txt");
+    }, std::runtime_error);
+
+    std::string filename = "test_bad_rules.txt";
+    {
+        std::ofstream out(filename);
+        out << "kills Dragon Knight\n";
+    }
+    EXPECT_THROW({
+        CombatRules::loadFromFile(filename);
+    }, std::invalid_argument);
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "../include/combat_kernel.h"
+#include "../include/factory.h"
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Columns {
+    std::vector<int> xs;
+    std::vector<int> ys;
+    std::vector<NpcTypeId> types;
+    std::vector<std::uint8_t> alive;
+
+    combat_kernel::Block block() const {
+        return {xs.data(), ys.data(), types.data(), alive.data(), xs.size()};
+    }
+};
+
+Columns randomColumns(size_t count, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> coord(0, 120);
+    std::uniform_int_distribution<> type(0, static_cast<int>(kNpcTypeCount) - 1);
+    std::uniform_int_distribution<> alive(0, 9);
+
+    Columns columns;
+    for (size_t i = 0; i < count; ++i) {
+        columns.xs.push_back(coord(gen));
+        columns.ys.push_back(coord(gen));
+        columns.types.push_back(static_cast<NpcTypeId>(type(gen)));
+        columns.alive.push_back(alive(gen) != 0 ? 1 : 0);
+    }
+    return columns;
+}
+
+// Эталон: та же проверка через Npc::distanceTo и CombatRules
+std::vector<std::uint32_t> referenceHits(const combat_kernel::Probe& probe, const Columns& columns) {
+    const CombatRules& rules = kDefaultCombatRules;
+    auto a = NpcFactory::createNpc(std::string(npcTypeName(probe.type)), "A", probe.x, probe.y);
+
+    std::vector<std::uint32_t> hits;
+    for (size_t i = 0; i < columns.xs.size(); ++i) {
+        if (!columns.alive[i]) continue;
+        auto b = NpcFactory::createNpc(std::string(npcTypeName(columns.types[i])), "B",
+                                       columns.xs[i], columns.ys[i]);
+        int radius = std::max(rules.getStats(a->getTypeId()).kill_distance,
+                              rules.getStats(b->getTypeId()).kill_distance);
+        if (a->distanceTo(*b) > radius) continue;
+        if (rules.canKill(a->getTypeId(), b->getTypeId()) ||
+            rules.canKill(b->getTypeId(), a->getTypeId())) {
+            hits.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+    return hits;
+}
+
+std::vector<std::uint32_t> kernelHits(combat_kernel::Impl impl, const combat_kernel::Probe& probe,
+                                      const Columns& columns) {
+    combat_kernel::Impl previous = combat_kernel::getImpl();
+    combat_kernel::setImpl(impl);
+
+    auto tables = combat_kernel::makeTables(kDefaultCombatRules);
+    std::vector<std::uint32_t> hits(columns.xs.size());
+    size_t found = combat_kernel::findHits(probe, columns.block(), tables, hits.data());
+    hits.resize(found);
+
+    combat_kernel::setImpl(previous);
+    return hits;
+}
+
+}
+
+// Тесты пакетного ядра проверки пар
+TEST(CombatKernelTest, ScalarMatchesReference) {
+    // Размер не кратен 8, чтобы задеть хвост блока
+    Columns columns = randomColumns(203, 7);
+    for (size_t t = 0; t < kNpcTypeCount; ++t) {
+        combat_kernel::Probe probe{60, 60, static_cast<NpcTypeId>(t)};
+        EXPECT_EQ(kernelHits(combat_kernel::Impl::Scalar, probe, columns),
+                  referenceHits(probe, columns));
+    }
+}
+
+TEST(CombatKernelTest, Avx2MatchesScalar) {
+    if (!combat_kernel::isAvx2Supported()) {
+        GTEST_SKIP() << "AVX2 is not supported on this CPU";
+    }
+
+    for (unsigned seed = 0; seed < 20; ++seed) {
+        Columns columns = randomColumns(8 * seed + seed % 8, seed);
+        for (size_t t = 0; t < kNpcTypeCount; ++t) {
+            combat_kernel::Probe probe{static_cast<int>(seed * 6), 50, static_cast<NpcTypeId>(t)};
+            EXPECT_EQ(kernelHits(combat_kernel::Impl::Avx2, probe, columns),
+                      kernelHits(combat_kernel::Impl::Scalar, probe, columns));
+        }
+    }
+}
+
+TEST(CombatKernelTest, BoundaryDistanceIsInclusive) {
+    Columns columns;
+    columns.xs = {50, 51, 30, 40};
+    columns.ys = {0, 0, 40, 30};
+    columns.types = {NpcTypeId::Knight, NpcTypeId::Knight, NpcTypeId::Druid, NpcTypeId::Elf};
+    columns.alive = {1, 1, 1, 1};
+
+    // Эльф достаёт на 50: (50, 0) ровно на границе, (51, 0) уже нет,
+    // (30, 40) - друид на расстоянии 50, (40, 30) - другой эльф (не враг)
+    combat_kernel::Probe elf{0, 0, NpcTypeId::Elf};
+    std::vector<std::uint32_t> expected = {0, 2};
+    EXPECT_EQ(kernelHits(combat_kernel::Impl::Scalar, elf, columns), expected);
+    EXPECT_EQ(kernelHits(combat_kernel::getImpl(), elf, columns), expected);
+}
+
+TEST(CombatKernelTest, UnavailableImplFallsBackToScalar) {
+    combat_kernel::Impl previous = combat_kernel::getImpl();
+    combat_kernel::setImpl(combat_kernel::Impl::Avx2);
+    if (!combat_kernel::isAvx2Supported()) {
+        EXPECT_EQ(combat_kernel::getImpl(), combat_kernel::Impl::Scalar);
+    } else {
+        EXPECT_EQ(combat_kernel::getImpl(), combat_kernel::Impl::Avx2);
+    }
+    combat_kernel::setImpl(previous);
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include "../include/arena.h"
+#include "../include/event_sink.h"
+#include "../include/console_observer.h"
+#include "../include/factory.h"
+#include "../include/game_engine.h"
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> splitLines(const std::string& text) {
+    std::vector<std::string> lines;
+    std::istringstream stream(text);
+    std::string line;
+    while (std::getline(stream, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+}
+
+TEST(EventSinkTest, FormatsRecordsThroughSources) {
+    std::ostringstream out;
+    EventSink sink(out);
+    std::uint32_t source = sink.addSource([](const EventRecord& record, std::string_view, std::string& line) {
+        line += "tick " + std::to_string(record.tick) + ": " + std::to_string(record.attacker) +
+                " -> " + std::to_string(record.defender) + "\n";
+    });
+
+    sink.push({7, 1, 2, source, EventKind::Kill});
+    sink.pushText("plain line");
+    sink.push({8, 3, 4, EventSink::kPlainText, EventKind::Kill});
+    sink.flush();
+
+    EXPECT_EQ(out.str(), "tick 7: 1 -> 2\nplain line\n3 killed 4\n");
+    EXPECT_EQ(sink.getWritten(), 3u);
+}
+
+TEST(EventSinkTest, FlushWaitsForOutput) {
+    // Поток журнала сам не просыпается: вывод только по flush
+    std::ostringstream out;
+    EventSink::Config config;
+    config.flush_interval = std::chrono::hours(1);
+    EventSink sink(out, config);
+
+    sink.pushText("first");
+    sink.flush();
+    EXPECT_EQ(out.str(), "first\n");
+
+    sink.pushText("second");
+    sink.flush();
+    EXPECT_EQ(out.str(), "first\nsecond\n");
+}
+
+TEST(EventSinkTest, DestructorWritesPendingRecords) {
+    std::ostringstream out;
+    {
+        EventSink::Config config;
+        config.flush_interval = std::chrono::hours(1);
+        EventSink sink(out, config);
+        for (int i = 0; i < 1000; ++i) {
+            sink.pushText("event " + std::to_string(i));
+        }
+    }
+
+    std::vector<std::string> lines = splitLines(out.str());
+    ASSERT_EQ(lines.size(), 1000u);
+    EXPECT_EQ(lines.front(), "event 0");
+    EXPECT_EQ(lines.back(), "event 999");
+}
+
+TEST(EventSinkTest, BoundedBuffersKeepOrderPerThread) {
+    const int threads = 4;
+    const int per_thread = 20000;
+    std::ostringstream out;
+    {
+        // Маленькие буферы: производители постоянно ждут потребителя
+        EventSink::Config config;
+        config.records_per_thread = 16;
+        config.text_per_thread = 64;
+        EventSink sink(out, config);
+
+        std::vector<std::thread> producers;
+        for (int t = 0; t < threads; ++t) {
+            producers.emplace_back([&sink, t] {
+                for (int i = 0; i < per_thread; ++i) {
+                    if (i % 2 == 0) {
+                        sink.push({static_cast<std::uint64_t>(i), static_cast<std::uint32_t>(t),
+                                   static_cast<std::uint32_t>(i), EventSink::kPlainText, EventKind::Kill});
+                    } else {
+                        sink.pushText(std::to_string(t) + " text " + std::to_string(i));
+                    }
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+    }
+
+    std::vector<int> next(threads, 0);
+    std::vector<std::string> lines = splitLines(out.str());
+    ASSERT_EQ(lines.size(), static_cast<size_t>(threads * per_thread));
+    for (const std::string& line : lines) {
+        std::istringstream fields(line);
+        int t = 0;
+        std::string word;
+        int i = 0;
+        fields >> t >> word >> i;
+        EXPECT_EQ(word, i % 2 == 0 ? "killed" : "text");
+        EXPECT_EQ(i, next[t]++);
+    }
+}
+
+TEST(EventSinkTest, RemovedSourceIsSkipped) {
+    std::ostringstream out;
+    EventSink sink(out);
+    std::uint32_t source = sink.addSource([](const EventRecord&, std::string_view text, std::string& line) {
+        line += "source: ";
+        line += text;
+        line += '\n';
+    });
+
+    sink.pushText("kept", source);
+    sink.removeSource(source);
+    sink.pushText("skipped", source);
+    sink.flush();
+
+    EXPECT_EQ(out.str(), "source: kept\n");
+}
+
+TEST(EventSinkTest, ConsoleObserverWritesThroughSink) {
+    auto out = std::make_shared<std::ostringstream>();
+    auto sink = std::make_shared<EventSink>(*out);
+    {
+        ConsoleObserver observer(sink);
+        observer.notify("Knight1 killed Elf1");
+    }
+
+    EXPECT_EQ(out->str(), "[BATTLE] Knight1 killed Elf1\n");
+}
+
+// Строки боя выводятся до возврата из startBattle, раньше последующего
+// прямого вывода в std::cout
+TEST(EventSinkTest, ArenaBattleLinesPrecedeLaterOutput) {
+    Arena arena;
+    arena.addObserver(std::make_shared<ConsoleObserver>());
+    arena.addNpc(NpcFactory::createNpc("Knight", "Knight1", 100, 100));
+    arena.addNpc(NpcFactory::createNpc("Elf", "Elf1", 110, 110));
+    arena.addNpc(NpcFactory::createNpc("Knight", "Knight2", 400, 400));
+
+    testing::internal::CaptureStdout();
+    arena.startBattle(50.0);
+    arena.printAllNpcs();
+    std::string output = testing::internal::GetCapturedStdout();
+
+    size_t battle = output.rfind("[BATTLE]");
+    size_t survivors = output.find("Name: Knight2");
+    ASSERT_NE(battle, std::string::npos);
+    ASSERT_NE(survivors, std::string::npos);
+    EXPECT_LT(battle, survivors);
+}
+
+TEST(EventSinkTest, EngineLogsKillsWithNames) {
+    std::ostringstream out;
+    auto sink = std::make_shared<EventSink>(out);
+
+    for (auto mode : {GameEngine::ExecutionMode::Threaded, GameEngine::ExecutionMode::Coroutines}) {
+        GameEngine engine(100, 100);
+        engine.setEventSink(sink);
+        engine.setExecutionMode(mode);
+        engine.setSeed(5);
+        engine.addNpc(NpcFactory::createNpc("Elf", "Elf1", 50, 50));
+        engine.addNpc(NpcFactory::createNpc("Knight", "Knight1", 50, 50));
+
+        for (int i = 0; i < 200 && engine.getSurvivors().size() == 2; ++i) {
+            engine.step();
+        }
+        engine.flushEvents();
+        std::vector<std::string> survivors = engine.getSurvivors();
+        ASSERT_LT(survivors.size(), 2u);
+
+        // Один победитель или взаимное убийство (ответный удар убитого)
+        std::string expected;
+        if (survivors.size() == 1) {
+            std::string victim = survivors.front() == "Elf1" ? "Knight1" : "Elf1";
+            expected = "[COMBAT] " + survivors.front() + " killed " + victim + "\n";
+        } else {
+            expected = "[COMBAT] Elf1 killed Knight1\n[COMBAT] Knight1 killed Elf1\n";
+        }
+        EXPECT_EQ(out.str(), expected);
+        out.str("");
+    }
+}
@@ -3,7 +3,12 @@
 #include "../include/knight.h"
 #include "../include/druid.h"
 #include "../include/elf.h"
+#include "../include/text_scenario.h"
+#include "../include/arena.h"
+#include "../include/game_engine.h"
 #include <memory>
+#include <memory_resource>
+#include <string>
 
 // Тесты фабрики
 TEST(FactoryTest, CreateKnight) {
@@ -90,3 +95,162 @@ TEST(FactoryTest, CreateFromStringEmptyLine) {
         auto npc = NpcFactory::createFromString(line);
     }, std::runtime_error);
 }
+
+// Тесты идентификаторов типов
+TEST(FactoryTest, AssignsTypeIds) {
+    EXPECT_EQ(NpcFactory::createNpc("Knight", "K", 0, 0)->getTypeId(), NpcTypeId::Knight);
+    EXPECT_EQ(NpcFactory::createNpc("Druid", "D", 0, 0)->getTypeId(), NpcTypeId::Druid);
+    EXPECT_EQ(NpcFactory::createNpc("Elf", "E", 0, 0)->getTypeId(), NpcTypeId::Elf);
+}
+
+TEST(FactoryTest, TypeNameRoundtrip) {
+    for (size_t i = 0; i < kNpcTypeCount; ++i) {
+        NpcTypeId id = static_cast<NpcTypeId>(i);
+        EXPECT_EQ(npcTypeFromName(npcTypeName(id)), id);
+    }
+    EXPECT_EQ(npcTypeFromName("Dragon"), NpcTypeId::Unknown);
+
+    static_assert(npcTypeFromName("Elf") == NpcTypeId::Elf);
+}
+
+TEST(FactoryTest, AccessorsDoNotCopy) {
+    auto knight = NpcFactory::createNpc("Knight", "Lancelot", 0, 0);
+
+    // Имя - представление буфера внутри объекта, тип - ссылка на общую строку
+    EXPECT_EQ(knight->getName().data(), knight->getName().data());
+    EXPECT_EQ(&knight->getType(), &knight->getType());
+}
+
+// Тесты разбора строки сценария
+TEST(FactoryTest, ParseLineMatchesStreamRules) {
+    text_scenario::Record record;
+    ASSERT_TRUE(text_scenario::parseLine("  Knight\tLancelot  +100 -20 extra", record));
+    EXPECT_EQ(record.type, "Knight");
+    EXPECT_EQ(record.name, "Lancelot");
+    EXPECT_EQ(record.x, 100);
+    EXPECT_EQ(record.y, -20);
+
+    // Хвост после числа не читается, как у operator>>
+    ASSERT_TRUE(text_scenario::parseLine("Elf Legolas 5 7x\r", record));
+    EXPECT_EQ(record.y, 7);
+}
+
+TEST(FactoryTest, ParseLineRejectsBadFields) {
+    text_scenario::Record record;
+    EXPECT_FALSE(text_scenario::parseLine("", record));
+    EXPECT_FALSE(text_scenario::parseLine("Knight Lancelot", record));
+    EXPECT_FALSE(text_scenario::parseLine("Knight Lancelot 10", record));
+    EXPECT_FALSE(text_scenario::parseLine("Knight Lancelot x 10", record));
+    EXPECT_FALSE(text_scenario::parseLine("Knight Lancelot 10 +-5", record));
+    EXPECT_FALSE(text_scenario::parseLine("Knight Lancelot 10 99999999999", record));
+}
+
+namespace {
+
+// Ресурс, считающий выделения и возвраты памяти
+class CountingResource : public std::pmr::memory_resource {
+    public:
+        size_t allocations = 0;
+        size_t deallocations = 0;
+        size_t bytes = 0;  // выделено и не возвращено
+
+    private:
+        void* do_allocate(size_t size, size_t alignment) override {
+            ++allocations;
+            bytes += size;
+            return std::pmr::new_delete_resource()->allocate(size, alignment);
+        }
+
+        void do_deallocate(void* p, size_t size, size_t alignment) override {
+            ++deallocations;
+            bytes -= size;
+            std::pmr::new_delete_resource()->deallocate(p, size, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+};
+
+}
+
+// Тесты выделения NPC из ресурса памяти
+TEST(FactoryTest, CreateNpcFromMemoryResource) {
+    CountingResource memory;
+    {
+        auto knight = NpcFactory::createNpc("Knight", "Lancelot", 1, 2, &memory);
+        auto elf = NpcFactory::createNpc(NpcTypeId::Elf, "Legolas", 3, 4, &memory);
+        EXPECT_EQ(memory.allocations, 2u);
+        EXPECT_EQ(knight->getName(), "Lancelot");
+        EXPECT_EQ(elf->getTypeId(), NpcTypeId::Elf);
+        EXPECT_NE(dynamic_cast<Knight*>(knight.get()), nullptr);
+
+        // Передача владения не трогает память
+        NpcPtr moved = std::move(knight);
+        EXPECT_EQ(moved->getX(), 1);
+        EXPECT_EQ(memory.deallocations, 0u);
+    }
+    EXPECT_EQ(memory.deallocations, 2u);
+    EXPECT_EQ(memory.bytes, 0u);
+
+    // Неизвестный тип не оставляет выделенной памяти
+    EXPECT_THROW(NpcFactory::createNpc("Dragon", "Smaug", 0, 0, &memory), std::invalid_argument);
+    EXPECT_EQ(memory.allocations, 2u);
+}
+
+TEST(FactoryTest, NpcPtrAcceptsMakeUnique) {
+    NpcPtr npc = std::make_unique<Druid>(5, 6, "Merlin");
+    EXPECT_EQ(npc->getType(), "Druid");
+    EXPECT_EQ(npc.get_deleter().resource, nullptr);
+
+    Arena arena;
+    arena.addNpc(std::make_unique<Knight>(10, 10, "Arthur"));
+    EXPECT_EQ(arena.getNpcCount(), 1u);
+}
+
+TEST(FactoryTest, ArenaUsesMonotonicResource) {
+    CountingResource upstream;
+    {
+        std::pmr::monotonic_buffer_resource memory(&upstream);
+        Arena arena(MAX_WIDTH, MAX_HEIGHT, &memory);
+        EXPECT_EQ(arena.getMemoryResource(), &memory);
+
+        for (int i = 0; i < 1000; ++i) {
+            arena.createAndAddNpc(i % 2 ? "Knight" : "Elf", "Npc" + std::to_string(i), i % 500, i % 500);
+        }
+
+        // NPC и узлы словаря - несколько больших блоков, а не 2000 выделений
+        EXPECT_LT(upstream.allocations, 20u);
+
+        arena.startBattle(50.0);
+        EXPECT_LT(arena.getNpcCount(), 1000u);
+
+        // Загрузка файла и параллельная загрузка идут через тот же ресурс
+        std::string filename = "test_factory_memory.txt";
+        arena.saveToFile(filename);
+        size_t count = arena.getNpcCount();
+        for (Arena::LoadMode mode : {Arena::LoadMode::Serial, Arena::LoadMode::Parallel}) {
+            Arena loaded(MAX_WIDTH, MAX_HEIGHT, &memory);
+            loaded.setLoadMode(mode, 2);
+            loaded.loadFromFile(filename);
+            EXPECT_EQ(loaded.getNpcCount(), count);
+        }
+        std::remove(filename.c_str());
+    }
+    EXPECT_EQ(upstream.bytes, 0u);
+}
+
+TEST(FactoryTest, EngineUsesPoolResource) {
+    CountingResource upstream;
+    {
+        std::pmr::unsynchronized_pool_resource memory(&upstream);
+        GameEngine engine(200, 200, &memory);
+        engine.setSeed(3);
+        engine.createRandomNpcs(500);
+        size_t allocations = upstream.allocations;
+        EXPECT_LT(allocations, 50u);
+        EXPECT_EQ(engine.getMemoryResource(), &memory);
+        EXPECT_EQ(engine.getSurvivors().size(), 500u);
+    }
+    EXPECT_EQ(upstream.bytes, 0u);
+}
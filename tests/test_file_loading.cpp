@@ -2,8 +2,14 @@
 #include "../include/arena.h"
 #include "../include/factory.h"
 #include "../include/console_observer.h"
+#include "test_helpers.h"
 #include <memory>
 #include <fstream>
+#include <cstdio>
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <vector>
 
 // Тест загрузки реального файла с данными
 TEST(FileLoadingTest, LoadRealFileAndVerify) {
@@ -124,3 +130,247 @@ TEST(FileLoadingTest, BattleWithLoadedNpcs) {
     
     EXPECT_GE(arena.getNpcCount(), 1);  // Хотя бы кто-то должен выжить
 }
+
+namespace {
+
+std::string readAll(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void writeAll(const std::string& filename, const std::string& content) {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file << content;
+}
+
+}
+
+TEST(FileLoadingTest, BinaryRoundTripMatchesText) {
+    std::string binaryFile = "temp_test_file.bin";
+    std::string textBefore = "temp_test_before.txt";
+    std::string textAfter = "temp_test_after.txt";
+
+    {
+        Arena arena;
+        arena.loadFromFile("test_data_npcs.txt");
+        arena.saveToFile(textBefore);
+        arena.saveToFile(binaryFile, Arena::FileFormat::Binary);
+    }
+
+    // Формат определяется по сигнатуре, имя файла не важно
+    Arena arena;
+    arena.loadFromFile(binaryFile);
+    EXPECT_EQ(arena.getNpcCount(), 5);
+    arena.saveToFile(textAfter);
+
+    EXPECT_EQ(readAll(textBefore), readAll(textAfter));
+    EXPECT_NE(readAll(binaryFile), readAll(textBefore));
+
+    std::remove(binaryFile.c_str());
+    std::remove(textBefore.c_str());
+    std::remove(textAfter.c_str());
+}
+
+TEST(FileLoadingTest, BinaryEmptyArena) {
+    std::string binaryFile = "temp_empty.bin";
+    Arena().saveToFile(binaryFile, Arena::FileFormat::Binary);
+
+    Arena arena;
+    arena.loadFromFile(binaryFile);
+    EXPECT_EQ(arena.getNpcCount(), 0);
+    std::remove(binaryFile.c_str());
+}
+
+TEST(FileLoadingTest, BinaryDuplicateNameThrows) {
+    std::string binaryFile = "temp_duplicate.bin";
+    {
+        Arena arena;
+        arena.loadFromFile("test_data_npcs.txt");
+        arena.saveToFile(binaryFile, Arena::FileFormat::Binary);
+    }
+
+    Arena arena;
+    arena.loadFromFile(binaryFile);
+    EXPECT_THROW(arena.loadFromFile(binaryFile), std::invalid_argument);
+    std::remove(binaryFile.c_str());
+}
+
+TEST(FileLoadingTest, BinaryRejectsDamagedFiles) {
+    std::string binaryFile = "temp_damaged.bin";
+    {
+        Arena arena;
+        arena.loadFromFile("test_data_npcs.txt");
+        arena.saveToFile(binaryFile, Arena::FileFormat::Binary);
+    }
+    const std::string original = readAll(binaryFile);
+
+    // Обрезанный файл
+    writeAll(binaryFile, original.substr(0, original.size() - 4));
+    EXPECT_THROW(Arena().loadFromFile(binaryFile), std::runtime_error);
+
+    // Другая версия формата
+    std::string future = original;
+    future[8] = 2;
+    writeAll(binaryFile, future);
+    EXPECT_THROW(Arena().loadFromFile(binaryFile), std::runtime_error);
+
+    // Неизвестный тип в колонке типов (сразу за 64-байтным заголовком)
+    std::string unknown = original;
+    unknown[64] = 7;
+    writeAll(binaryFile, unknown);
+    EXPECT_THROW(Arena().loadFromFile(binaryFile), std::invalid_argument);
+
+    std::remove(binaryFile.c_str());
+}
+
+TEST(FileLoadingTest, MissingFileThrows) {
+    EXPECT_THROW(Arena().loadFromFile("no_such_file.txt"), std::runtime_error);
+}
+
+TEST(FileLoadingTest, TextErrorsReportLineNumbers) {
+    std::string textFile = "temp_bad_lines.txt";
+
+    writeAll(textFile, "Knight Lancelot 100 200\n\nElf Legolas 50\n");
+    try {
+        Arena().loadFromFile(textFile);
+        FAIL() << "expected std::runtime_error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_STREQ(e.what(), "Failed to read line 3: Elf Legolas 50");
+    }
+
+    writeAll(textFile, "Knight Lancelot 100 200\nDragon Smaug 1 1");
+    try {
+        Arena().loadFromFile(textFile);
+        FAIL() << "expected std::invalid_argument";
+    } catch (const std::invalid_argument& e) {
+        EXPECT_STREQ(e.what(), "Unknown NPC type (line 2): Dragon");
+    }
+
+    std::remove(textFile.c_str());
+}
+
+TEST(FileLoadingTest, TextWithoutTrailingNewline) {
+    std::string textFile = "temp_no_newline.txt";
+    writeAll(textFile, "Knight Lancelot 100 200\r\nElf Legolas 50 75");
+
+    Arena arena;
+    arena.loadFromFile(textFile);
+    EXPECT_EQ(arena.getNpcCount(), 2);
+    std::remove(textFile.c_str());
+}
+
+namespace {
+
+// Сценарий примерно на 1.5 МБ, чтобы параллельная загрузка делила его на куски
+std::string bigScenario(size_t count) {
+    const char* kTypes[] = {"Knight", "Druid", "Elf"};
+    std::string text;
+    for (size_t i = 0; i < count; ++i) {
+        // Имена не по порядку, чтобы слияние действительно сортировало
+        size_t id = (i * 7919) % count;
+        text += std::string(kTypes[i % 3]) + " npc_" + std::to_string(id) + " " +
+                std::to_string(i % 500) + " " + std::to_string((i / 500) % 500) + "\n";
+        if (i % 1000 == 999) text += "\n";
+    }
+    return text;
+}
+
+// Тип и текст исключения загрузки ("" если загрузилось)
+std::string loadError(const std::string& filename, Arena::LoadMode mode, size_t workers,
+                      size_t* count = nullptr) {
+    Arena arena;
+    arena.setLoadMode(mode, workers);
+    std::string result;
+    try {
+        arena.loadFromFile(filename);
+    } catch (const std::invalid_argument& e) {
+        result = std::string("invalid_argument: ") + e.what();
+    } catch (const std::out_of_range& e) {
+        result = std::string("out_of_range: ") + e.what();
+    } catch (const std::runtime_error& e) {
+        result = std::string("runtime_error: ") + e.what();
+    }
+    if (count) *count = arena.getNpcCount();
+    return result;
+}
+
+}
+
+TEST(FileLoadingTest, ParallelLoadMatchesSerial) {
+    TempDir dir;
+    const std::string textFile = dir.file("parallel.txt");
+    const std::string binaryFile = dir.file("parallel.bin");
+    const std::string expectedFile = dir.file("parallel_expected.txt");
+    const std::string actualFile = dir.file("parallel_actual.txt");
+    writeAll(textFile, bigScenario(60000));
+
+    Arena serial;
+    serial.loadFromFile(textFile);
+    serial.saveToFile(expectedFile);
+    serial.saveToFile(binaryFile, Arena::FileFormat::Binary);
+    ASSERT_EQ(serial.getNpcCount(), 60000);
+
+    for (const std::string& source : {textFile, binaryFile}) {
+        for (size_t workers : {1, 3, 8}) {
+            Arena parallel;
+            parallel.setLoadMode(Arena::LoadMode::Parallel, workers);
+            EXPECT_EQ(parallel.getLoadWorkerCount(), workers);
+            parallel.loadFromFile(source);
+            parallel.saveToFile(actualFile);
+            EXPECT_EQ(readAll(actualFile), readAll(expectedFile)) << source << " / " << workers;
+        }
+    }
+}
+
+TEST(FileLoadingTest, ParallelLoadMergesIntoExistingNpcs) {
+    TempDir dir;
+    const std::string textFile = dir.file("parallel_merge.txt");
+    writeAll(textFile, bigScenario(20000));
+
+    Arena arena;
+    arena.setLoadMode(Arena::LoadMode::Parallel, 4);
+    arena.createAndAddNpc("Knight", "aaa", 1, 1);
+    arena.createAndAddNpc("Knight", "zzz", 1, 1);
+    arena.loadFromFile(textFile);
+    EXPECT_EQ(arena.getNpcCount(), 20002);
+
+    // Повторная загрузка - конфликт с уже загруженными, арена не меняется
+    EXPECT_THROW(arena.loadFromFile(textFile), std::invalid_argument);
+    EXPECT_EQ(arena.getNpcCount(), 20002);
+}
+
+TEST(FileLoadingTest, ParallelLoadReportsFirstErrorLikeSerial) {
+    TempDir dir;
+    const std::string textFile = dir.file("parallel_errors.txt");
+    const std::string base = bigScenario(60000);
+
+    // Ошибка в строке - место первой ошибки в последовательной загрузке
+    auto withLine = [&](size_t lineNumber, const std::string& line) {
+        std::string text = base;
+        size_t pos = 0;
+        for (size_t i = 1; i < lineNumber; ++i) pos = text.find('\n', pos) + 1;
+        text.insert(pos, line + "\n");
+        return text;
+    };
+
+    const std::vector<std::string> scenarios = {
+        withLine(45000, "Knight broken 10"),
+        withLine(45000, "Dragon Smaug 1 1"),
+        withLine(45000, "Elf far_away 900 1"),
+        withLine(45000, "Elf npc_17 1 1"),                               // дубликат позже оригинала
+        withLine(2, "Elf npc_59999 1 1"),                                // первый из пары - в файле раньше
+        withLine(40000, "Elf npc_3 1 1") + "Knight broken 10\n",         // дубликат раньше ошибки
+        withLine(50000, "Elf npc_3 1 1").insert(0, "Knight broken 10\n"),
+    };
+
+    for (const std::string& text : scenarios) {
+        writeAll(textFile, text);
+        std::string expected = loadError(textFile, Arena::LoadMode::Serial, 1);
+        ASSERT_FALSE(expected.empty());
+        for (size_t workers : {1, 4}) {
+            size_t count = 1;
+            EXPECT_EQ(loadError(textFile, Arena::LoadMode::Parallel, workers, &count), expected);
+            EXPECT_EQ(count, 0u);
+        }
+    }
+}
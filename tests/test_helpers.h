@@ -0,0 +1,44 @@
+#pragma once
+#include <gtest/gtest.h>
+#include "../include/game_engine.h"
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+
+// Общие заготовки тестов
+
+// Шаги без задержек и без вывода карты
+inline GameEngine::TickConfig headless() {
+    GameEngine::TickConfig config;
+    config.realtime = false;
+    config.display_every = 0;
+    return config;
+}
+
+// Отдельный каталог во временной директории на время теста; удаляется
+// деструктором, в том числе когда тест прерван проваленным ASSERT
+class TempDir {
+    public:
+        TempDir() {
+            const auto* test = ::testing::UnitTest::GetInstance()->current_test_info();
+            path_ = std::filesystem::temp_directory_path() /
+                    (std::string("lab7_") + test->name() + "_" + std::to_string(::getpid()));
+            std::filesystem::remove_all(path_);
+            std::filesystem::create_directories(path_);
+        }
+
+        ~TempDir() {
+            std::error_code error;
+            std::filesystem::remove_all(path_, error);
+        }
+
+        TempDir(const TempDir&) = delete;
+        TempDir& operator=(const TempDir&) = delete;
+
+        std::string file(const std::string& name) const {
+            return (path_ / name).string();
+        }
+
+    private:
+        std::filesystem::path path_;
+};
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "../include/map_renderer.h"
+#include "../include/game_engine.h"
+#include "../include/factory.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+WorldSnapshot makeSnapshot(int width, int height) {
+    WorldSnapshot snapshot;
+    snapshot.width = width;
+    snapshot.height = height;
+    snapshot.names = std::make_shared<const std::vector<std::string>>();
+    return snapshot;
+}
+
+void place(WorldSnapshot& snapshot, int x, int y, NpcTypeId type, bool alive = true) {
+    snapshot.xs.push_back(x);
+    snapshot.ys.push_back(y);
+    snapshot.types.push_back(type);
+    snapshot.alive.push_back(alive ? 1 : 0);
+}
+
+// Строка кадра с клетками ряда y
+std::string rowLine(const std::string& frame, int y) {
+    std::string prefix = "| " + std::string(y < 10 ? " " : "") + std::to_string(y) + " ";
+    size_t start = frame.find("\n" + prefix);
+    if (start == std::string::npos) return {};
+    start += 1;
+    return frame.substr(start, frame.find('\n', start) - start);
+}
+
+}
+
+// Тесты отрисовки карты
+TEST(MapRendererTest, FullFramePlotsNpcs) {
+    MapRenderer renderer(20, 5);
+    WorldSnapshot snapshot = makeSnapshot(20, 5);
+    place(snapshot, 0, 0, NpcTypeId::Knight);
+    place(snapshot, 3, 2, NpcTypeId::Druid);
+    place(snapshot, 3, 2, NpcTypeId::Elf);
+    place(snapshot, 19, 4, NpcTypeId::Elf);
+    place(snapshot, 5, 4, NpcTypeId::Knight, false);
+
+    const std::string& frame = renderer.render(snapshot);
+
+    EXPECT_EQ(rowLine(frame, 0), "|  0 K................... |");
+    EXPECT_EQ(rowLine(frame, 2), "|  2 ...*................ |");
+    EXPECT_EQ(rowLine(frame, 4), "|  4 ...................E |");
+    EXPECT_NE(frame.find("| Alive NPCs: 4/5        |\n"), std::string::npos);
+    EXPECT_NE(frame.find("[MAP] GAME WORLD STATE"), std::string::npos);
+    EXPECT_EQ(frame.find("\x1b["), std::string::npos);
+}
+
+TEST(MapRendererTest, FullFrameIsRedrawnFromScratch) {
+    MapRenderer renderer(10, 3);
+    WorldSnapshot first = makeSnapshot(10, 3);
+    place(first, 1, 1, NpcTypeId::Knight);
+    renderer.render(first);
+
+    WorldSnapshot second = makeSnapshot(10, 3);
+    place(second, 2, 1, NpcTypeId::Knight);
+    const std::string& frame = renderer.render(second);
+
+    EXPECT_EQ(rowLine(frame, 1), "|  1 ..K....... |");
+}
+
+TEST(MapRendererTest, UnknownTypeShownAsQuestionMark) {
+    MapRenderer renderer(10, 2);
+    WorldSnapshot snapshot = makeSnapshot(10, 2);
+    place(snapshot, 4, 1, NpcTypeId::Unknown);
+
+    EXPECT_EQ(rowLine(renderer.render(snapshot), 1), "|  1 ....?..... |");
+}
+
+TEST(MapRendererTest, DiffFirstFrameClearsScreen) {
+    MapRenderer renderer(10, 3);
+    WorldSnapshot snapshot = makeSnapshot(10, 3);
+    place(snapshot, 1, 1, NpcTypeId::Knight);
+
+    const std::string& full = renderer.render(snapshot, MapRenderer::Mode::Full);
+    std::string expected = "\x1b[H\x1b[2J" + full;
+    EXPECT_EQ(renderer.render(snapshot, MapRenderer::Mode::Diff), expected);
+}
+
+TEST(MapRendererTest, DiffWritesOnlyChangedCells) {
+    MapRenderer renderer(10, 3);
+    WorldSnapshot before = makeSnapshot(10, 3);
+    place(before, 1, 1, NpcTypeId::Knight);
+    place(before, 5, 2, NpcTypeId::Elf);
+    renderer.render(before, MapRenderer::Mode::Diff);
+
+    // Без изменений - только курсор под кадр
+    std::string idle = renderer.render(before, MapRenderer::Mode::Diff);
+    EXPECT_EQ(idle.find('K'), std::string::npos);
+    EXPECT_EQ(idle.find("Alive"), std::string::npos);
+    EXPECT_LT(idle.size(), 16);
+
+    // Рыцарь сдвинулся на клетку вправо: одна пачка ".K" с позиции x = 1
+    WorldSnapshot after = makeSnapshot(10, 3);
+    place(after, 2, 1, NpcTypeId::Knight);
+    place(after, 5, 2, NpcTypeId::Elf);
+    std::string moved = renderer.render(after, MapRenderer::Mode::Diff);
+
+    // Шапка: пустая строка, три строки рамки и строка номеров - ряд 0 на строке 6.
+    // Клетки начинаются после "|  1 " (столбец 6), x = 1 - столбец 7
+    EXPECT_EQ(moved.find("\x1b[7;7H.K"), 0u);
+    EXPECT_EQ(moved.find("Alive"), std::string::npos);
+}
+
+TEST(MapRendererTest, DiffRewritesCounterWhenItChanges) {
+    MapRenderer renderer(10, 3);
+    WorldSnapshot before = makeSnapshot(10, 3);
+    place(before, 1, 1, NpcTypeId::Knight);
+    place(before, 5, 2, NpcTypeId::Elf);
+    renderer.render(before, MapRenderer::Mode::Diff);
+
+    WorldSnapshot after = before;
+    after.alive[1] = 0;
+    std::string diff = renderer.render(after, MapRenderer::Mode::Diff);
+
+    EXPECT_NE(diff.find("\x1b[8;11H."), std::string::npos);
+    EXPECT_NE(diff.find("| Alive NPCs: 1/2           |\x1b[K"), std::string::npos);
+}
+
+TEST(MapRendererTest, ResetForcesFullRedraw) {
+    MapRenderer renderer(10, 3);
+    WorldSnapshot snapshot = makeSnapshot(10, 3);
+    renderer.render(snapshot, MapRenderer::Mode::Diff);
+    renderer.reset();
+    EXPECT_EQ(renderer.render(snapshot, MapRenderer::Mode::Diff).rfind("\x1b[H\x1b[2J", 0), 0u);
+}
+
+TEST(MapRendererTest, EnginePrintsSameFrame) {
+    GameEngine engine(30, 10);
+    engine.addNpc(NpcFactory::createNpc("Knight", "Knight1", 3, 4));
+    engine.addNpc(NpcFactory::createNpc("Elf", "Elf1", 29, 9));
+
+    testing::internal::CaptureStdout();
+    engine.printMap();
+    std::string output = testing::internal::GetCapturedStdout();
+
+    MapRenderer renderer(30, 10);
+    EXPECT_EQ(output, renderer.render(*engine.getSnapshot()));
+    EXPECT_EQ(rowLine(output, 4), "|  4 ...K.......................... |");
+}
@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include "../include/mpmc_queue.h"
+#include "../include/game_engine.h"
+#include "../include/factory.h"
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+// Тесты очереди MPMC
+TEST(MpmcQueueTest, FifoSingleThread) {
+    MpmcQueue<int> queue(8);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+
+    int value = -1;
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST(MpmcQueueTest, CapacityRoundedToPowerOfTwo) {
+    MpmcQueue<int> queue(5);
+    EXPECT_EQ(queue.capacity(), 8);
+
+    EXPECT_THROW({
+        MpmcQueue<int> tiny(1);
+    }, std::invalid_argument);
+}
+
+TEST(MpmcQueueTest, FullQueueDropsAndCounts) {
+    MpmcQueue<int> queue(4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_FALSE(queue.tryPush(100));
+    EXPECT_FALSE(queue.tryPush(101));
+
+    QueueStats stats = queue.getStats();
+    EXPECT_EQ(stats.pushed, 4);
+    EXPECT_EQ(stats.dropped, 2);
+    EXPECT_EQ(stats.depth, 4);
+    EXPECT_EQ(stats.high_water, 4);
+
+    std::vector<int> batch;
+    EXPECT_EQ(queue.popBatch(batch, 3), 3);
+    EXPECT_EQ(batch, (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(queue.getStats().depth, 1);
+    EXPECT_EQ(queue.getStats().high_water, 4);
+}
+
+TEST(MpmcQueueTest, BlockingConsumerWakesOnPush) {
+    MpmcQueue<int> queue(16);
+    std::vector<int> batch;
+
+    std::thread consumer([&] {
+        queue.popBatch(batch, 16);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.tryPush(42);
+    consumer.join();
+
+    EXPECT_EQ(batch, (std::vector<int>{42}));
+}
+
+TEST(MpmcQueueTest, CloseWakesConsumers) {
+    MpmcQueue<int> queue(16);
+    std::atomic<int> finished{0};
+
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < 3; ++i) {
+        consumers.emplace_back([&] {
+            std::vector<int> batch;
+            EXPECT_EQ(queue.popBatch(batch, 4), 0);
+            ++finished;
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.close();
+    for (auto& t : consumers) t.join();
+
+    EXPECT_EQ(finished, 3);
+    EXPECT_FALSE(queue.tryPush(1));
+}
+
+TEST(MpmcQueueTest, ManyProducersManyConsumers) {
+    const int kProducers = 4;
+    const int kConsumers = 4;
+    const int kPerProducer = 20000;
+
+    MpmcQueue<int> queue(1024);
+    std::atomic<long long> sum{0};
+    std::atomic<int> received{0};
+
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < kConsumers; ++c) {
+        consumers.emplace_back([&] {
+            std::vector<int> batch;
+            while (queue.popBatch(batch, 64) > 0) {
+                for (int v : batch) sum += v;
+                received += static_cast<int>(batch.size());
+                batch.clear();
+            }
+        });
+    }
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 1; i <= kPerProducer; ++i) {
+                // Обратное давление: ждём, пока потребители освободят место
+                while (!queue.tryPush(p * kPerProducer + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : producers) t.join();
+
+    while (received < kProducers * kPerProducer) {
+        std::this_thread::yield();
+    }
+    queue.close();
+    for (auto& t : consumers) t.join();
+
+    long long n = static_cast<long long>(kProducers) * kPerProducer;
+    EXPECT_EQ(sum, n * (n + 1) / 2);
+    EXPECT_EQ(queue.getStats().popped, static_cast<std::uint64_t>(n));
+}
+
+TEST(MpmcQueueTest, EngineExposesQueueStats) {
+    GameEngine engine(100, 100);
+    auto stats = engine.getCombatStats();
+    EXPECT_EQ(stats.queue.pushed, 0);
+    EXPECT_EQ(stats.queue.depth, 0);
+    EXPECT_GT(stats.queue.capacity, 0);
+    EXPECT_EQ(stats.duplicates_dropped, 0);
+}
+
+// Пара, уже ожидающая в очереди, повторно не ставится
+TEST(MpmcQueueTest, EngineDeduplicatesPendingPairs) {
+    GameEngine engine(100, 100);
+    engine.addNpc(NpcFactory::createNpc("Knight", "Knight1", 10, 10));
+    engine.addNpc(NpcFactory::createNpc("Elf", "Elf1", 15, 10));
+    engine.addNpc(NpcFactory::createNpc("Druid", "Druid1", 80, 80));
+    engine.addNpc(NpcFactory::createNpc("Druid", "Druid2", 82, 80));
+
+    engine.detectAndQueueCombats();
+    engine.detectAndQueueCombats();
+    engine.detectAndQueueCombats();
+
+    auto stats = engine.getCombatStats();
+    EXPECT_EQ(stats.queue.pushed, 2);
+    EXPECT_EQ(stats.queue.depth, 2);
+    EXPECT_EQ(stats.duplicates_dropped, 4);
+    EXPECT_EQ(stats.pending_pairs, 2);
+}
+
+// Шаг ставит каждую найденную пару один раз, не заполняя множество
+// ожидающих пар
+TEST(MpmcQueueTest, EngineStepQueuesEachPairOnce) {
+    std::ostringstream log;
+    GameEngine engine(50, 50);
+    engine.setSeed(5);
+    engine.setEventSink(std::make_shared<EventSink>(log));
+    engine.createRandomNpcs(300);
+
+    for (int i = 0; i < 3; ++i) {
+        engine.step();
+    }
+
+    auto stats = engine.getCombatStats();
+    EXPECT_GT(stats.queue.pushed, 0);
+    EXPECT_EQ(stats.queue.pushed, stats.queue.popped);
+    EXPECT_EQ(stats.duplicates_dropped, 0);
+    EXPECT_EQ(stats.pending_pairs, 0);
+}
+
+// Плотный мир: пар за шаг больше ёмкости очереди, но ни одна не теряется,
+// и исход совпадает с режимом корутин, где очереди нет
+TEST(MpmcQueueTest, EngineKeepsPairsBeyondQueueCapacity) {
+    auto simulate = [](GameEngine::ExecutionMode mode) {
+        std::ostringstream log;
+        GameEngine engine(40, 40);
+        engine.setSeed(42);
+        engine.setExecutionMode(mode);
+        engine.setEventSink(std::make_shared<EventSink>(log));
+        engine.createRandomNpcs(1000);
+        engine.step();
+        return std::make_pair(engine.getSurvivors(), engine.getCombatStats());
+    };
+
+    auto [threaded, stats] = simulate(GameEngine::ExecutionMode::Threaded);
+    auto [coroutines, unused] = simulate(GameEngine::ExecutionMode::Coroutines);
+
+    EXPECT_GT(stats.queue.pushed, stats.queue.capacity);
+    EXPECT_EQ(stats.queue.pushed, stats.queue.popped);
+    EXPECT_EQ(stats.pending_pairs, 0);
+    EXPECT_LT(threaded.size(), 1000);
+    EXPECT_EQ(threaded, coroutines);
+}
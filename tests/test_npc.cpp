@@ -4,6 +4,8 @@
 #include "../include/druid.h"
 #include "../include/elf.h"
 #include <memory>
+#include <stdexcept>
+#include <string>
 
 // Тесты создания NPC
 TEST(NpcTest, CreateKnight) {
@@ -67,3 +69,34 @@ TEST(NpcTest, BoundaryCoordinates) {
     EXPECT_EQ(knight2.getX(), 500);
     EXPECT_EQ(knight2.getY(), 500);
 }
+
+// Тип - только идентификатор, строка типа общая для всех NPC
+TEST(NpcTest, TypeStringIsShared) {
+    Knight knight(1, 1, "Arthur");
+    Knight other(2, 2, "Percival");
+    Elf elf(3, 3, "Legolas");
+
+    EXPECT_EQ(&knight.getType(), &other.getType());
+    EXPECT_EQ(knight.getType(), "Knight");
+    EXPECT_EQ(elf.getType(), "Elf");
+    EXPECT_EQ(&elf.getType(), &npcTypeString(NpcTypeId::Elf));
+    EXPECT_EQ(npcTypeString(NpcTypeId::Unknown), "Unknown");
+}
+
+// Имя лежит в буфере внутри объекта, без отдельного выделения памяти
+TEST(NpcTest, NameIsStoredInline) {
+    Knight knight(1, 1, "Sir_Bedivere_the_Wise");
+    const char* object = reinterpret_cast<const char*>(&knight);
+    const char* name = knight.getName().data();
+
+    EXPECT_EQ(knight.getName(), "Sir_Bedivere_the_Wise");
+    EXPECT_GE(name, object);
+    EXPECT_LT(name, object + sizeof(Knight));
+    EXPECT_LE(sizeof(Npc), 48u);
+}
+
+TEST(NpcTest, NameLongerThanCapacityThrows) {
+    std::string longest(NpcName::kCapacity, 'a');
+    EXPECT_EQ(Elf(0, 0, longest).getName(), longest);
+    EXPECT_THROW(Elf(0, 0, longest + "a"), std::invalid_argument);
+}
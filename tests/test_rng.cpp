@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "../include/rng.h"
+#include "../include/game_engine.h"
+#include <array>
+#include <string>
+#include <vector>
+
+// Тесты счётчикового генератора
+TEST(RngTest, SameKeySameSequence) {
+    rng::CounterRng a(42, rng::Stream::Movement, 7, 100);
+    rng::CounterRng b(42, rng::Stream::Movement, 7, 100);
+    for (int i = 0; i < 16; ++i) {
+        EXPECT_EQ(a.next(), b.next());
+    }
+}
+
+TEST(RngTest, DifferentKeysDiffer) {
+    const std::uint64_t base = rng::CounterRng(42, rng::Stream::Movement, 7, 100).next();
+    EXPECT_NE(base, rng::CounterRng(43, rng::Stream::Movement, 7, 100).next());
+    EXPECT_NE(base, rng::CounterRng(42, rng::Stream::Combat, 7, 100).next());
+    EXPECT_NE(base, rng::CounterRng(42, rng::Stream::Movement, 8, 100).next());
+    EXPECT_NE(base, rng::CounterRng(42, rng::Stream::Movement, 7, 101).next());
+}
+
+TEST(RngTest, UniformStaysInRangeAndCoversIt) {
+    std::array<int, 6> counts{};
+    for (std::uint64_t object = 0; object < 60000; ++object) {
+        rng::CounterRng dice(1, rng::Stream::Combat, 0, object);
+        int value = dice.uniform(1, 6);
+        ASSERT_GE(value, 1);
+        ASSERT_LE(value, 6);
+        counts[value - 1]++;
+    }
+
+    for (int count : counts) {
+        EXPECT_NEAR(count, 10000, 500);
+    }
+}
+
+namespace {
+
+std::vector<std::string> simulate(std::uint64_t seed, size_t workers, GameEngine::ExecutionMode mode) {
+    GameEngine engine(300, 300);
+    engine.setSeed(seed);
+    engine.setWorkerCount(workers);
+    engine.setExecutionMode(mode);
+
+    GameEngine::TickConfig config;
+    config.realtime = false;
+    config.display_every = 0;
+    engine.setTickConfig(config);
+
+    engine.createRandomNpcs(1000);
+
+    testing::internal::CaptureStdout();
+    engine.runTicks(50);
+    testing::internal::GetCapturedStdout();
+    return engine.getSurvivors();
+}
+
+}
+
+// Одно зерно - один исход при любом числе потоков и в режиме корутин
+TEST(RngTest, EngineReproducibleAcrossThreadCounts) {
+    auto single = simulate(2024, 1, GameEngine::ExecutionMode::Threaded);
+    EXPECT_LT(single.size(), 1000);
+
+    EXPECT_EQ(single, simulate(2024, 1, GameEngine::ExecutionMode::Threaded));
+    EXPECT_EQ(single, simulate(2024, 4, GameEngine::ExecutionMode::Threaded));
+    EXPECT_EQ(single, simulate(2024, 1, GameEngine::ExecutionMode::Coroutines));
+}
+
+TEST(RngTest, EngineSeedChangesOutcome) {
+    EXPECT_NE(simulate(1, 2, GameEngine::ExecutionMode::Threaded),
+              simulate(2, 2, GameEngine::ExecutionMode::Threaded));
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "../include/spatial_grid.h"
+#include "../include/game_engine.h"
+#include "../include/factory.h"
+#include <memory>
+#include <set>
+#include <sstream>
+#include <utility>
+
+namespace {
+
+std::set<std::pair<WorldStore::Index, WorldStore::Index>> toSet(const std::vector<MovementTask>& tasks) {
+    std::set<std::pair<WorldStore::Index, WorldStore::Index>> result;
+    for (const auto& task : tasks) {
+        result.insert({task.npc1, task.npc2});
+    }
+    return result;
+}
+
+size_t countPairs(const SpatialGrid& grid) {
+    size_t count = 0;
+    grid.forEachCandidatePair([&](SpatialGrid::Index, SpatialGrid::Index) { ++count; });
+    return count;
+}
+
+}
+
+// Тесты пространственной сетки
+TEST(SpatialGridTest, InsertAndRemove) {
+    SpatialGrid grid(100, 100, 10);
+
+    grid.insert(0, 5, 5);
+    grid.insert(1, 6, 6);
+    EXPECT_EQ(grid.size(), 2);
+    EXPECT_EQ(countPairs(grid), 1);
+
+    grid.remove(0, 5, 5);
+    EXPECT_EQ(grid.size(), 1);
+    EXPECT_EQ(countPairs(grid), 0);
+}
+
+TEST(SpatialGridTest, NeighbourCellsOnly) {
+    SpatialGrid grid(100, 100, 10);
+
+    grid.insert(0, 9, 9);
+    grid.insert(1, 10, 10);
+    grid.insert(2, 50, 50);
+
+    // Пара в соседних ячейках находится, дальний NPC не попадает в кандидаты
+    EXPECT_EQ(countPairs(grid), 1);
+}
+
+TEST(SpatialGridTest, UpdateMovesBetweenCells) {
+    SpatialGrid grid(100, 100, 10);
+
+    grid.insert(0, 0, 0);
+    grid.insert(1, 55, 55);
+    EXPECT_EQ(countPairs(grid), 0);
+
+    grid.update(0, 0, 0, 50, 50);
+    EXPECT_EQ(countPairs(grid), 1);
+    EXPECT_EQ(grid.size(), 2);
+}
+
+// Сетка должна находить те же пары, что и полный перебор
+TEST(SpatialGridTest, EngineGridMatchesBruteForce) {
+    GameEngine engine(200, 200);
+    engine.createRandomNpcs(300);
+
+    engine.setDetectionMode(GameEngine::DetectionMode::BruteForce);
+    auto brute = toSet(engine.findCombatPairs());
+
+    engine.setDetectionMode(GameEngine::DetectionMode::Grid);
+    auto grid = toSet(engine.findCombatPairs());
+
+    EXPECT_FALSE(brute.empty());
+    EXPECT_EQ(brute, grid);
+}
+
+TEST(SpatialGridTest, EngineFindsPairInRange) {
+    GameEngine engine(100, 100);
+    engine.addNpc(NpcFactory::createNpc("Knight", "Knight1", 10, 10));
+    engine.addNpc(NpcFactory::createNpc("Elf", "Elf1", 50, 10));
+    engine.addNpc(NpcFactory::createNpc("Knight", "Knight2", 90, 90));
+
+    auto pairs = engine.findCombatPairs();
+    ASSERT_EQ(pairs.size(), 1);
+    auto snapshot = engine.getSnapshot();
+    EXPECT_EQ(snapshot->getName(pairs[0].npc1), "Elf1");
+    EXPECT_EQ(snapshot->getName(pairs[0].npc2), "Knight1");
+}
+
+// Убитый NPC, снова добавленный по имени до следующего шага, остаётся в
+// сетке на новом месте: сетка находит те же пары, что и перебор
+TEST(SpatialGridTest, EngineGridTracksNpcReaddedAfterDeath) {
+    std::ostringstream log;
+    GameEngine engine(300, 300);
+    engine.setSeed(16);
+    engine.setEventSink(std::make_shared<EventSink>(log));
+    engine.addNpc(NpcFactory::createNpc("Elf", "Elf1", 50, 50));
+    engine.addNpc(NpcFactory::createNpc("Knight", "Knight1", 50, 50));
+
+    for (int i = 0; i < 200 && engine.getSurvivors().size() == 2; ++i) {
+        engine.step();
+    }
+    auto survivors = engine.getSurvivors();
+    ASSERT_EQ(survivors.size(), 1);
+    bool elf_died = survivors[0] == "Knight1";
+    std::string victim = elf_died ? "Elf1" : "Knight1";
+
+    // Вдали от выжившего и от прежней ячейки: следующий шаг обходится без боя
+    engine.addNpc(NpcFactory::createNpc(elf_died ? "Elf" : "Knight", victim, 280, 280));
+    engine.step();
+
+    auto snapshot = engine.getSnapshot();
+    WorldStore::Index index = 0;
+    while (snapshot->getName(index) != victim) ++index;
+    ASSERT_TRUE(snapshot->alive[index]);
+    engine.addNpc(NpcFactory::createNpc(elf_died ? "Knight" : "Elf", "Probe",
+                                        snapshot->xs[index], snapshot->ys[index]));
+
+    engine.setDetectionMode(GameEngine::DetectionMode::BruteForce);
+    auto brute = toSet(engine.findCombatPairs());
+    engine.setDetectionMode(GameEngine::DetectionMode::Grid);
+    auto grid = toSet(engine.findCombatPairs());
+
+    EXPECT_FALSE(brute.empty());
+    EXPECT_EQ(brute, grid);
+}
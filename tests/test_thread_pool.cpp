@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include "../include/thread_pool.h"
+#include "../include/game_engine.h"
+#include "../include/factory.h"
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Тесты пула с кражей работы
+TEST(ThreadPoolTest, RunExecutesAllTasks) {
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4);
+
+    std::atomic<int> counter{0};
+    std::vector<ThreadPool::Task> tasks;
+    for (int i = 0; i < 1000; ++i) {
+        tasks.push_back([&counter] { counter++; });
+    }
+    pool.run(std::move(tasks));
+
+    EXPECT_EQ(counter.load(), 1000);
+    EXPECT_GE(pool.getStats().executed, 1000);
+}
+
+TEST(ThreadPoolTest, ParallelForCoversRangeOnce) {
+    ThreadPool pool(3);
+    std::vector<int> hits(10007, 0);
+
+    pool.parallelFor(0, hits.size(), 16, [&hits](size_t from, size_t to) {
+        for (size_t i = from; i < to; ++i) hits[i]++;
+    });
+
+    EXPECT_EQ(std::accumulate(hits.begin(), hits.end(), 0), 10007);
+    for (int hit : hits) {
+        EXPECT_EQ(hit, 1);
+    }
+}
+
+TEST(ThreadPoolTest, NestedParallelForDoesNotDeadlock) {
+    ThreadPool pool(2);
+    std::atomic<int> counter{0};
+
+    // Ожидающий поток сам выполняет задачи, поэтому вложенные пачки
+    // не блокируют рабочих
+    pool.parallelFor(0, 8, 1, [&](size_t from, size_t to) {
+        for (size_t i = from; i < to; ++i) {
+            pool.parallelFor(0, 100, 1, [&](size_t a, size_t b) {
+                counter += static_cast<int>(b - a);
+            });
+        }
+    });
+
+    EXPECT_EQ(counter.load(), 800);
+}
+
+TEST(ThreadPoolTest, ExceptionIsRethrown) {
+    ThreadPool pool(2);
+    std::vector<ThreadPool::Task> tasks;
+    tasks.push_back([] {});
+    tasks.push_back([] { throw std::runtime_error("task failed"); });
+
+    EXPECT_THROW(pool.run(std::move(tasks)), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, SubmitPassesExceptionThroughFuture) {
+    ThreadPool pool(2);
+    auto failed = pool.submit([] { throw std::runtime_error("task failed"); });
+    auto done = pool.submit([] {});
+
+    EXPECT_THROW(failed.get(), std::runtime_error);
+    EXPECT_NO_THROW(done.get());
+
+    // Рабочий поток пережил исключение и выполняет следующие задачи
+    std::atomic<int> counter{0};
+    pool.parallelFor(0, 100, 1, [&](size_t from, size_t to) {
+        counter += static_cast<int>(to - from);
+    });
+    EXPECT_EQ(counter.load(), 100);
+}
+
+TEST(ThreadPoolTest, WaitingCallerSleeps) {
+    // Задачи пачки заняты в рабочих; вызывающий не должен крутиться,
+    // пока они не закончатся: его процессорное время мало
+    ThreadPool pool(2);
+    std::vector<ThreadPool::Task> tasks;
+    for (int i = 0; i < 2; ++i) {
+        tasks.push_back([] { std::this_thread::sleep_for(std::chrono::milliseconds(200)); });
+    }
+
+    std::clock_t cpu_before = std::clock();
+    auto start = std::chrono::steady_clock::now();
+    pool.run(std::move(tasks));
+    auto wall = std::chrono::steady_clock::now() - start;
+    double cpu = static_cast<double>(std::clock() - cpu_before) / CLOCKS_PER_SEC;
+
+    EXPECT_GE(wall, std::chrono::milliseconds(200));
+    EXPECT_LT(cpu, 0.1);
+}
+
+TEST(ThreadPoolTest, ZeroWorkersBecomesOne) {
+    ThreadPool pool(0);
+    EXPECT_EQ(pool.size(), 1);
+}
+
+// Пары сетки не зависят от числа потоков пула
+TEST(ThreadPoolTest, EngineDetectionIndependentOfWorkerCount) {
+    GameEngine engine(500, 500);
+    engine.createRandomNpcs(2000);
+
+    engine.setWorkerCount(1);
+    auto single = engine.findCombatPairs();
+
+    engine.setWorkerCount(4);
+    EXPECT_EQ(engine.getWorkerCount(), 4);
+    auto parallel = engine.findCombatPairs();
+
+    ASSERT_EQ(single.size(), parallel.size());
+    for (size_t i = 0; i < single.size(); ++i) {
+        EXPECT_EQ(single[i].npc1, parallel[i].npc1);
+        EXPECT_EQ(single[i].npc2, parallel[i].npc2);
+    }
+}
+
+// Шаг симуляции разбирает очередь боёв полностью
+TEST(ThreadPoolTest, EngineStepDrainsCombatQueue) {
+    GameEngine engine(100, 100);
+    engine.setWorkerCount(4);
+    engine.createRandomNpcs(200);
+
+    for (int i = 0; i < 5; ++i) {
+        engine.step();
+    }
+
+    auto stats = engine.getCombatStats();
+    EXPECT_EQ(stats.queue.depth, 0);
+    EXPECT_EQ(stats.pending_pairs, 0);
+    EXPECT_EQ(stats.queue.pushed, stats.queue.popped);
+}
+
+// Пачки боёв идут параллельно, но исход и порядок убийств - как при одном потоке
+TEST(ThreadPoolTest, EngineCombatIndependentOfWorkerCount) {
+    auto simulate = [](size_t workers) {
+        // Плотная толпа: у многих NPC по несколько противников в одном шаге
+        std::ostringstream log;
+        GameEngine engine(60, 60);
+        engine.setEventSink(std::make_shared<EventSink>(log));
+        engine.setSeed(77);
+        engine.setWorkerCount(workers);
+        engine.createRandomNpcs(3000);
+        for (int i = 0; i < 3; ++i) {
+            engine.step();
+        }
+        engine.flushEvents();
+        return std::make_pair(engine.getSurvivors(), log.str());
+    };
+
+    auto single = simulate(1);
+    EXPECT_LT(single.first.size(), 3000u);
+    EXPECT_FALSE(single.second.empty());
+    EXPECT_EQ(simulate(4), single);
+    EXPECT_EQ(simulate(8), single);
+}
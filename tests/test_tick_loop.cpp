@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "../include/game_engine.h"
+#include "../include/factory.h"
+#include "test_helpers.h"
+#include <stdexcept>
+
+// Тесты прогона шагов
+TEST(TickLoopTest, HeadlessRunsAllTicksWithoutSleeping) {
+    GameEngine engine(100, 100);
+    engine.setTickConfig(headless());
+    engine.addNpc(NpcFactory::createNpc("Druid", "Druid1", 5, 5));
+
+    // 30 секунд симуляции - 300 шагов без задержек
+    auto stats = engine.runTicks(30 * GameEngine::kTicksPerSecond);
+
+    EXPECT_EQ(stats.ticks, 300);
+    EXPECT_EQ(engine.getTick(), 300);
+    EXPECT_EQ(stats.late_ticks, 0);
+    EXPECT_LT(stats.seconds, 1.0);
+    EXPECT_GT(stats.ticks_per_second, 300.0);
+}
+
+TEST(TickLoopTest, RealtimeKeepsFixedRate) {
+    GameEngine engine(100, 100);
+    GameEngine::TickConfig config;
+    config.ticks_per_second = 100.0;
+    config.display_every = 0;
+    engine.setTickConfig(config);
+
+    auto stats = engine.runTicks(10);
+
+    EXPECT_EQ(stats.ticks, 10);
+    EXPECT_GE(stats.seconds, 0.095);
+}
+
+TEST(TickLoopTest, RejectsNonPositiveRealtimeRate) {
+    GameEngine engine(100, 100);
+    GameEngine::TickConfig config;
+    config.ticks_per_second = 0.0;
+
+    EXPECT_THROW(engine.setTickConfig(config), std::invalid_argument);
+
+    config.realtime = false;
+    EXPECT_NO_THROW(engine.setTickConfig(config));
+    EXPECT_FALSE(engine.getTickConfig().realtime);
+}
+
+TEST(TickLoopTest, DisplayEveryNTicks) {
+    GameEngine engine(10, 10);
+    GameEngine::TickConfig config = headless();
+    config.display_every = 5;
+    engine.setTickConfig(config);
+
+    testing::internal::CaptureStdout();
+    engine.runTicks(12);
+    std::string output = testing::internal::GetCapturedStdout();
+
+    size_t maps = 0;
+    for (size_t pos = output.find("Alive NPCs"); pos != std::string::npos;
+         pos = output.find("Alive NPCs", pos + 1)) {
+        ++maps;
+    }
+    EXPECT_EQ(maps, 2);
+}
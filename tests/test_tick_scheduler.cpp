@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "../include/tick_scheduler.h"
+#include "../include/game_engine.h"
+#include "../include/factory.h"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+TickTask recorder(TickScheduler& scheduler, std::vector<std::string>& log, std::string name, int ticks) {
+    for (int i = 0; i < ticks; ++i) {
+        log.push_back(name + std::to_string(i));
+        co_await scheduler.nextTick();
+    }
+}
+
+TickTask failing(TickScheduler& scheduler) {
+    co_await scheduler.nextTick();
+    throw std::runtime_error("routine failed");
+}
+
+}
+
+// Тесты планировщика шагов
+TEST(TickSchedulerTest, ResumesInSpawnOrderEachTick) {
+    TickScheduler scheduler;
+    std::vector<std::string> log;
+    scheduler.spawn(recorder(scheduler, log, "a", 2));
+    scheduler.spawn(recorder(scheduler, log, "b", 2));
+
+    // Корутины создаются приостановленными
+    EXPECT_TRUE(log.empty());
+
+    scheduler.runTick();
+    EXPECT_EQ(log, (std::vector<std::string>{"a0", "b0"}));
+
+    scheduler.runTick();
+    scheduler.runTick();
+    EXPECT_EQ(log, (std::vector<std::string>{"a0", "b0", "a1", "b1"}));
+
+    EXPECT_EQ(scheduler.getTick(), 3);
+    EXPECT_EQ(scheduler.getResumes(), 6);
+    EXPECT_EQ(scheduler.size(), 2);
+
+    // Завершённые корутины больше не возобновляются
+    scheduler.runTick();
+    EXPECT_EQ(scheduler.getResumes(), 6);
+}
+
+TEST(TickSchedulerTest, ExceptionPropagatesAndOthersContinue) {
+    TickScheduler scheduler;
+    std::vector<std::string> log;
+    scheduler.spawn(failing(scheduler));
+    scheduler.spawn(recorder(scheduler, log, "a", 3));
+
+    scheduler.runTick();
+    EXPECT_THROW(scheduler.runTick(), std::runtime_error);
+    EXPECT_EQ(log, (std::vector<std::string>{"a0"}));
+
+    // Не возобновлённые в шаге с ошибкой продолжают со следующего
+    scheduler.runTick();
+    scheduler.runTick();
+    EXPECT_EQ(log, (std::vector<std::string>{"a0", "a1", "a2"}));
+}
+
+TEST(TickSchedulerTest, ClearDestroysSuspendedRoutines) {
+    TickScheduler scheduler;
+    std::vector<std::string> log;
+    scheduler.spawn(recorder(scheduler, log, "a", 100));
+    scheduler.runTick();
+
+    scheduler.clear();
+    EXPECT_EQ(scheduler.size(), 0);
+    scheduler.runTick();
+    EXPECT_EQ(log.size(), 1);
+}
+
+// Режим корутин находит те же пары, что и пул потоков
+TEST(TickSchedulerTest, EngineCoroutineDetectionMatchesThreaded) {
+    GameEngine engine(500, 500);
+    engine.createRandomNpcs(1000);
+
+    auto threaded = engine.findCombatPairs();
+    engine.setExecutionMode(GameEngine::ExecutionMode::Coroutines);
+    EXPECT_EQ(engine.getExecutionMode(), GameEngine::ExecutionMode::Coroutines);
+    auto coroutines = engine.findCombatPairs();
+
+    ASSERT_EQ(threaded.size(), coroutines.size());
+    for (size_t i = 0; i < threaded.size(); ++i) {
+        EXPECT_EQ(threaded[i].npc1, coroutines[i].npc1);
+        EXPECT_EQ(threaded[i].npc2, coroutines[i].npc2);
+    }
+}
+
+// Шаги в режиме корутин: бои идут, очередь не используется
+TEST(TickSchedulerTest, EngineCoroutineStepsFight) {
+    GameEngine engine(100, 100);
+    engine.setExecutionMode(GameEngine::ExecutionMode::Coroutines);
+    engine.addNpc(NpcFactory::createNpc("Elf", "Elf1", 50, 50));
+    engine.addNpc(NpcFactory::createNpc("Knight", "Knight1", 50, 50));
+    engine.addNpc(NpcFactory::createNpc("Druid", "Druid1", 0, 0));
+    engine.addNpc(NpcFactory::createNpc("Druid", "Druid2", 0, 0));
+
+    testing::internal::CaptureStdout();
+    for (int i = 0; i < 200 && engine.getSurvivors().size() == 4; ++i) {
+        engine.step();
+    }
+    engine.flushEvents();
+    std::string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_LT(engine.getSurvivors().size(), 4);
+    EXPECT_NE(output.find("[COMBAT]"), std::string::npos);
+    EXPECT_EQ(engine.getCombatStats().queue.pushed, 0);
+}
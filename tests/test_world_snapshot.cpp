@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "../include/world_snapshot.h"
+#include "../include/game_engine.h"
+#include "../include/factory.h"
+#include "test_helpers.h"
+#include <atomic>
+#include <thread>
+
+// Тесты снимков мира
+TEST(WorldSnapshotTest, ReflectsAddedNpcs) {
+    GameEngine engine(100, 100);
+    engine.addNpc(NpcFactory::createNpc("Knight", "Knight1", 10, 20));
+    engine.addNpc(NpcFactory::createNpc("Elf", "Elf1", 90, 90));
+
+    auto snapshot = engine.getSnapshot();
+    ASSERT_EQ(snapshot->size(), 2);
+    EXPECT_EQ(snapshot->tick, 0);
+    EXPECT_EQ(snapshot->width, 100);
+    EXPECT_EQ(snapshot->xs[0], 10);
+    EXPECT_EQ(snapshot->ys[0], 20);
+    EXPECT_EQ(snapshot->types[1], NpcTypeId::Elf);
+    EXPECT_EQ(snapshot->aliveCount(), 2);
+    EXPECT_EQ(snapshot->survivors(), (std::vector<std::string>{"Elf1", "Knight1"}));
+
+    // Без изменений отдаётся тот же снимок
+    EXPECT_EQ(engine.getSnapshot(), snapshot);
+
+    engine.addNpc(NpcFactory::createNpc("Druid", "Druid1", 50, 50));
+    EXPECT_EQ(engine.getSnapshot()->size(), 3);
+}
+
+TEST(WorldSnapshotTest, HeldSnapshotIsImmutable) {
+    GameEngine engine(100, 100);
+    engine.setSeed(7);
+    engine.addNpc(NpcFactory::createNpc("Knight", "Knight1", 50, 50));
+
+    auto before = engine.getSnapshot();
+    int x = before->xs[0];
+    int y = before->ys[0];
+
+    for (int i = 0; i < 10; ++i) {
+        engine.step();
+    }
+
+    auto after = engine.getSnapshot();
+    EXPECT_EQ(after->tick, 10);
+    EXPECT_NE(after, before);
+    EXPECT_EQ(before->tick, 0);
+    EXPECT_EQ(before->xs[0], x);
+    EXPECT_EQ(before->ys[0], y);
+    EXPECT_TRUE(after->xs[0] != x || after->ys[0] != y);
+}
+
+TEST(WorldSnapshotTest, ReadersDoNotBlockSimulation) {
+    GameEngine engine(200, 200);
+    engine.setTickConfig(headless());
+    engine.createRandomNpcs(500);
+    engine.getSnapshot();
+
+    std::atomic<bool> done{false};
+    std::atomic<std::uint64_t> last_tick{0};
+    std::thread reader([&] {
+        while (!done) {
+            auto snapshot = engine.getSnapshot();
+            EXPECT_GE(snapshot->tick, last_tick.load());
+            EXPECT_EQ(snapshot->size(), 500);
+            last_tick = snapshot->tick;
+        }
+    });
+
+    testing::internal::CaptureStdout();
+    engine.runTicks(100);
+    testing::internal::GetCapturedStdout();
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(engine.getSnapshot()->tick, 100);
+    EXPECT_EQ(engine.getSurvivors(), engine.getSnapshot()->survivors());
+}
@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+#include "../include/world_store.h"
+#include "../include/game_engine.h"
+#include "../include/factory.h"
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <thread>
+
+// Тесты хранилища мира
+TEST(WorldStoreTest, AddAndFind) {
+    WorldStore store;
+    auto knight = store.add("Lancelot", NpcTypeId::Knight, 10, 20, true);
+    auto elf = store.add("Legolas", NpcTypeId::Elf, 30, 40, true);
+
+    EXPECT_EQ(store.size(), 2);
+    EXPECT_EQ(store.find("Lancelot"), knight);
+    EXPECT_EQ(store.find("Legolas"), elf);
+    EXPECT_EQ(store.find("Nobody"), WorldStore::kNotFound);
+
+    EXPECT_EQ(store.getX(elf), 30);
+    EXPECT_EQ(store.getY(elf), 40);
+    EXPECT_EQ(store.getType(elf), "Elf");
+    EXPECT_EQ(store.getName(knight), "Lancelot");
+}
+
+TEST(WorldStoreTest, ContiguousColumns) {
+    WorldStore store;
+    store.add("Knight1", NpcTypeId::Knight, 1, 2, true);
+    store.add("Knight2", NpcTypeId::Knight, 3, 4, true);
+    store.add("Druid1", NpcTypeId::Druid, 5, 6, true);
+
+    EXPECT_EQ(store.getXs(), (std::vector<int>{1, 3, 5}));
+    EXPECT_EQ(store.getYs(), (std::vector<int>{2, 4, 6}));
+
+    // type_id хранится отдельным массивом
+    EXPECT_EQ(store.getTypeId(0), store.getTypeId(1));
+    EXPECT_NE(store.getTypeId(0), store.getTypeId(2));
+    EXPECT_EQ(store.getTypeIds()[2], NpcTypeId::Druid);
+}
+
+// Имена лежат подряд в одном буфере, NPC хранит только смещение
+TEST(WorldStoreTest, NamesShareOneBuffer) {
+    WorldStore store;
+    store.add("Knight1", NpcTypeId::Knight, 1, 2, true);
+    store.add("Druid_with_a_long_name", NpcTypeId::Druid, 3, 4, true);
+    store.add("Knight1", NpcTypeId::Knight, 5, 6, true);  // замена не дописывает имя
+
+    ASSERT_EQ(store.size(), 2);
+    EXPECT_EQ(store.getName(1), "Druid_with_a_long_name");
+    EXPECT_EQ(store.getName(1).data(), store.getName(0).data() + store.getName(0).size());
+    EXPECT_EQ(store.copyNames(), (std::vector<std::string>{"Knight1", "Druid_with_a_long_name"}));
+
+    store.clear();
+    EXPECT_EQ(store.find("Knight1"), WorldStore::kNotFound);
+    EXPECT_EQ(store.getName(store.add("Elf1", NpcTypeId::Elf, 0, 0, true)), "Elf1");
+}
+
+TEST(WorldStoreTest, DuplicateNameOverwritesSlot) {
+    WorldStore store;
+    store.add("Same", NpcTypeId::Knight, 1, 1, true);
+    auto i = store.add("Same", NpcTypeId::Elf, 7, 8, true);
+
+    EXPECT_EQ(store.size(), 1);
+    EXPECT_EQ(store.getTypeId(i), NpcTypeId::Elf);
+    EXPECT_EQ(store.getX(i), 7);
+}
+
+TEST(WorldStoreTest, KillAndSetPosition) {
+    WorldStore store;
+    auto i = store.add("Merlin", NpcTypeId::Druid, 0, 0, true);
+
+    store.setPosition(i, 5, 6);
+    EXPECT_EQ(store.getX(i), 5);
+    EXPECT_EQ(store.getY(i), 6);
+
+    store.kill(i);
+    EXPECT_FALSE(store.isAlive(i));
+    EXPECT_EQ(store.getAlive()[i], 0);
+}
+
+// Параллельные kill: NPC убивает ровно один вызов
+TEST(WorldStoreTest, ConcurrentKillHasSingleWinner) {
+    WorldStore store;
+    for (int i = 0; i < 100; ++i) {
+        store.add("Npc" + std::to_string(i), NpcTypeId::Elf, i, i, true);
+    }
+
+    std::atomic<int> kills{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&] {
+            for (WorldStore::Index i = 0; i < store.size(); ++i) {
+                if (store.kill(i)) kills++;
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_EQ(kills.load(), 100);
+    EXPECT_FALSE(store.kill(0));
+}
+
+// Фасад addNpc/getSurvivors поверх хранилища
+TEST(WorldStoreTest, EngineFacade) {
+    GameEngine engine(100, 100);
+    engine.addNpc(NpcFactory::createNpc("Knight", "Knight2", 10, 10));
+    engine.addNpc(NpcFactory::createNpc("Elf", "Elf1", 20, 20));
+    engine.addNpc(NpcFactory::createNpc("Druid", "Druid1", 30, 30));
+
+    auto survivors = engine.getSurvivors();
+    EXPECT_EQ(survivors, (std::vector<std::string>{"Druid1", "Elf1", "Knight2"}));
+}
+
+TEST(WorldStoreTest, AppendBatchIsFoundByName) {
+    WorldStore store;
+    store.add("Old", NpcTypeId::Knight, 1, 1, true);
+
+    std::vector<std::string> names;
+    std::vector<NpcTypeId> types;
+    std::vector<int> xs;
+    std::vector<int> ys;
+    for (int i = 0; i < 5000; ++i) {
+        names.push_back("Npc" + std::to_string(i));
+        types.push_back(NpcTypeId::Elf);
+        xs.push_back(i);
+        ys.push_back(2 * i);
+    }
+
+    ThreadPool pool(4);
+    EXPECT_EQ(store.append(names, types, xs, ys, pool, 64), 1u);
+    ASSERT_EQ(store.size(), 5001u);
+    EXPECT_EQ(store.find("Old"), 0u);
+    for (int i = 0; i < 5000; ++i) {
+        WorldStore::Index index = store.find("Npc" + std::to_string(i));
+        ASSERT_EQ(index, static_cast<WorldStore::Index>(i + 1));
+        EXPECT_EQ(store.getY(index), 2 * i);
+        EXPECT_TRUE(store.isAlive(index));
+    }
+    EXPECT_EQ(store.find("Npc5000"), WorldStore::kNotFound);
+
+    // После пачки add по-прежнему заменяет по имени
+    EXPECT_EQ(store.add("Npc7", NpcTypeId::Druid, 0, 0, true), 8u);
+    EXPECT_EQ(store.size(), 5001u);
+}
+
+// Массовое создание NPC
+TEST(WorldStoreTest, SpawnMatchesCreateRandomNpcs) {
+    GameEngine spawned(200, 200);
+    spawned.setSeed(3);
+    spawned.setWorkerCount(4);
+    spawned.spawnNpcs(3000);
+
+    GameEngine created(200, 200);
+    created.setSeed(3);
+    created.setWorkerCount(1);
+    created.createRandomNpcs(3000);
+
+    auto a = spawned.getSnapshot();
+    auto b = created.getSnapshot();
+    ASSERT_EQ(a->size(), 3000u);
+    EXPECT_EQ(a->xs, b->xs);
+    EXPECT_EQ(a->ys, b->ys);
+    EXPECT_EQ(a->types, b->types);
+    EXPECT_EQ(*a->names, *b->names);
+    EXPECT_EQ(a->getName(17), std::string(npcTypeName(a->types[17])) + "_17");
+}
+
+TEST(WorldStoreTest, SpawnDistributionsStayOnMap) {
+    for (auto distribution : {GameEngine::SpawnDistribution::Clustered,
+                              GameEngine::SpawnDistribution::Gaussian}) {
+        GameEngine engine(1000, 500);
+        engine.setSeed(9);
+        GameEngine::SpawnConfig config;
+        config.distribution = distribution;
+        config.clusters = 1;
+        config.spread = 0.02;
+        engine.spawnNpcs(5000, config);
+
+        auto snapshot = engine.getSnapshot();
+        ASSERT_EQ(snapshot->size(), 5000u);
+        auto [min_x, max_x] = std::minmax_element(snapshot->xs.begin(), snapshot->xs.end());
+        auto [min_y, max_y] = std::minmax_element(snapshot->ys.begin(), snapshot->ys.end());
+        EXPECT_GE(*min_x, 0);
+        EXPECT_LT(*max_x, 1000);
+        EXPECT_GE(*min_y, 0);
+        EXPECT_LT(*max_y, 500);
+
+        // Одно скопление с сигмой / полушириной 10: все NPC рядом друг с другом
+        EXPECT_LT(*max_x - *min_x, 100);
+        EXPECT_LT(*max_y - *min_y, 100);
+    }
+}
+
+TEST(WorldStoreTest, SpawnReplacesExistingNames) {
+    // Заняты все имена, которые может дать spawnNpcs(10)
+    GameEngine engine(100, 100);
+    for (const char* type : {"Knight", "Druid", "Elf"}) {
+        for (int i = 0; i < 10; ++i) {
+            engine.addNpc(NpcFactory::createNpc(type, std::string(type) + "_" + std::to_string(i), 99, 99));
+        }
+    }
+    engine.spawnNpcs(10);
+
+    auto snapshot = engine.getSnapshot();
+    EXPECT_EQ(snapshot->size(), 30u);
+    EXPECT_EQ(engine.getSurvivors().size(), 30u);
+    EXPECT_LT(std::count(snapshot->xs.begin(), snapshot->xs.end(), 99), 30);
+}
+
+TEST(WorldStoreTest, ConcurrentSpawnsMatchSerial) {
+    // Одинаковые вызовы: в каком бы порядке они ни прошли, второй видит
+    // мир после первого целиком
+    GameEngine serial(300, 300);
+    serial.setSeed(11);
+    serial.spawnNpcs(5000);
+    serial.spawnNpcs(5000);
+
+    GameEngine concurrent(300, 300);
+    concurrent.setSeed(11);
+    std::thread other([&concurrent] { concurrent.spawnNpcs(5000); });
+    concurrent.spawnNpcs(5000);
+    other.join();
+
+    auto a = serial.getSnapshot();
+    auto b = concurrent.getSnapshot();
+    EXPECT_EQ(*a->names, *b->names);
+    EXPECT_EQ(a->xs, b->xs);
+    EXPECT_EQ(a->ys, b->ys);
+    EXPECT_EQ(a->types, b->types);
+}
+
+TEST(WorldStoreTest, SpawnRejectsBadConfig) {
+    GameEngine engine(100, 100);
+    GameEngine::SpawnConfig config;
+    config.distribution = GameEngine::SpawnDistribution::Gaussian;
+    config.clusters = 0;
+    EXPECT_THROW(engine.spawnNpcs(10, config), std::invalid_argument);
+
+    config.clusters = 2;
+    config.spread = -1.0;
+    EXPECT_THROW(engine.spawnNpcs(10, config), std::invalid_argument);
+    EXPECT_EQ(engine.getSnapshot()->size(), 0u);
+}